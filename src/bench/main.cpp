@@ -0,0 +1,597 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <game/allocation_tracker.h>
+#include <game/animation.h>
+#include <game/bot.h>
+#include <game/graphics/score.h>
+#include <game/graphics/text.h>
+#include <game/initial_position.h>
+#include <game/log.h>
+#include <game/performance_counters.h>
+#include <game/resource_loader.h>
+#include <game/world.h>
+#include <game/world_inspector.h>
+
+
+namespace
+{
+
+/// Количество прогонов каждого измерения. Выводится медиана.
+constexpr std::size_t REPETITIONS = 5;
+/// Интервал обновления мира.
+const Duration TICK(1.0 / 60);
+/// Количество обновлений мира в прогоне: минута игры.
+constexpr std::size_t SCENARIO_TICKS = 60 * 60;
+/// Обновления мира перед измерением запросов, чтобы на поле
+/// накопились ящики.
+constexpr std::size_t WARMUP_TICKS = 60 * 20;
+/// Количество операций в прогоне для коротких операций.
+constexpr std::size_t QUERY_OPERATIONS = 1000000;
+/// Количество операций в прогоне для операций, создающих объекты.
+constexpr std::size_t CONSTRUCTION_OPERATIONS = 100000;
+constexpr std::uint32_t SEED = 1;
+/// Начальное положение с наиболее заполненным полем.
+constexpr unsigned int DENSE_POSITION_INDEX = 5;
+/// Размерность текстуры игрока в спрайтах.
+const sf::Vector2u PLAYER_TEXTURE_SIZE(5, 3);
+const TextureSpriteIndices ANIMATION_WALK{ { 1, 0 }, { 1, 1 }, { 1, 2 } };
+/// Допустимое замедление относительно базовых результатов.
+constexpr double REGRESSION_THRESHOLD = 0.1;
+/// Допустимый прирост количества выделений памяти на операцию.
+constexpr double ALLOCATIONS_THRESHOLD = 0.01;
+constexpr int NAME_WIDTH = 44;
+constexpr int VALUE_WIDTH = 12;
+
+/// Получатель результатов, чтобы компилятор не удалил вычисления.
+volatile std::uint64_t sink = 0;
+
+
+template<typename T>
+void consume(T value)
+{
+    sink = sink + std::uint64_t(value);
+}
+
+
+/// Выполняет прогон: заданное количество операций.
+using Run = std::function<void()>;
+
+
+struct Benchmark
+{
+    std::string name;
+    /// Количество операций в прогоне.
+    std::size_t operations;
+    /// Готовит состояние, не входящее в измерение, и возвращает прогон.
+    std::function<Run()> prepare;
+};
+
+
+struct Result
+{
+    double nanoseconds{ 0 };
+    double allocations{ 0 };
+    // Не сохраняются в базовых результатах.
+    double bytes{ 0 };
+    /// Количество выполненных инструкций на такт.
+    double instructionsPerCycle{ 0 };
+    double cacheMisses{ 0 };
+    double branchMisses{ 0 };
+};
+
+
+/// Игра бота с фиксированными начальными условиями.
+/// Оконченная игра начинается заново с теми же условиями.
+class Scenario final
+{
+public:
+    Scenario(const std::optional<unsigned int> &positionIndex, std::uint8_t cranesQuantity)
+        : m_positionIndex(positionIndex)
+        , m_cranesQuantity(cranesQuantity)
+        , m_bot(SEED)
+    {
+        WorldInspector::start(m_world, m_positionIndex, SEED, m_cranesQuantity);
+    }
+
+    void tick()
+    {
+        if (m_world.gameOver())
+        {
+            WorldInspector::start(m_world, m_positionIndex, SEED, m_cranesQuantity);
+            m_bot = RandomBot(SEED);
+        }
+        m_bot.update(m_world, TICK);
+        m_world.update(TICK);
+    }
+
+    const World& world() const noexcept
+    {
+        return m_world;
+    }
+
+private:
+    const std::optional<unsigned int> m_positionIndex;
+    const std::uint8_t m_cranesQuantity;
+    World m_world;
+    RandomBot m_bot;
+};
+
+
+/// \return Мир с ящиками на поле для измерения запросов к нему.
+std::shared_ptr<const Scenario> makeLoadedScenario()
+{
+    std::shared_ptr<Scenario> scenario =
+        std::make_shared<Scenario>(DENSE_POSITION_INDEX, std::uint8_t(MAX_CRANES_QUANTITY));
+    for (std::size_t i = 0; i < WARMUP_TICKS; ++i)
+    {
+        scenario->tick();
+    }
+    return scenario;
+}
+
+
+std::vector<BoxPtr> boxes(const World &world)
+{
+    std::vector<BoxPtr> result;
+    for (const auto &[id, box] : WorldInspector::boxes(world))
+    {
+        result.push_back(box);
+    }
+    return result;
+}
+
+
+void addWorldBenchmarks(std::vector<Benchmark> &benchmarks)
+{
+    std::vector<std::optional<unsigned int>> positions{ std::nullopt };
+    for (unsigned int i = 0; i < INITIAL_POSITIONS.size(); ++i)
+    {
+        positions.push_back(i);
+    }
+
+    for (const std::uint8_t cranesQuantity :
+        { std::uint8_t(1), std::uint8_t(MAX_CRANES_QUANTITY) })
+    {
+        for (const std::optional<unsigned int> &position : positions)
+        {
+            std::stringstream name;
+            name << "World::update/" << unsigned(cranesQuantity) << " cranes/";
+            if (position.has_value())
+            {
+                name << "position " << position.value();
+            }
+            else
+            {
+                name << "random";
+            }
+            benchmarks.push_back(Benchmark{
+                name.str(),
+                SCENARIO_TICKS,
+                [position, cranesQuantity]() -> Run
+                {
+                    std::shared_ptr<Scenario> scenario =
+                        std::make_shared<Scenario>(position, cranesQuantity);
+                    return [scenario]()
+                    {
+                        for (std::size_t i = 0; i < SCENARIO_TICKS; ++i)
+                        {
+                            scenario->tick();
+                        }
+                    };
+                } });
+        }
+    }
+}
+
+
+void addQueryBenchmarks(std::vector<Benchmark> &benchmarks)
+{
+    benchmarks.push_back(Benchmark{
+        "World::columnHeight",
+        QUERY_OPERATIONS,
+        []() -> Run
+        {
+            std::shared_ptr<const Scenario> scenario = makeLoadedScenario();
+            return [scenario]()
+            {
+                for (std::size_t i = 0; i < QUERY_OPERATIONS; ++i)
+                {
+                    consume(WorldInspector::columnHeight(
+                        scenario->world(),
+                        Coordinate(i % BOXES_COLUMNS)));
+                }
+            };
+        } });
+
+    const std::vector<std::pair<Player::Direction, std::string>> directions
+    {
+        { Player::Direction::Left, "left" },
+        { Player::Direction::Right, "right" },
+        { Player::Direction::Up, "up" },
+        { Player::Direction::UpLeft, "up left" },
+        { Player::Direction::UpRight, "up right" }
+    };
+    for (const auto &[direction, directionName] : directions)
+    {
+        benchmarks.push_back(Benchmark{
+            "World::canPlayerMove/" + directionName,
+            QUERY_OPERATIONS,
+            [direction = direction]() -> Run
+            {
+                std::shared_ptr<const Scenario> scenario = makeLoadedScenario();
+                return [scenario, direction]()
+                {
+                    const World &world = scenario->world();
+                    for (std::size_t i = 0; i < QUERY_OPERATIONS; ++i)
+                    {
+                        // Игрок стоит на стопке в каждой из колонок по очереди.
+                        const Coordinate column = Coordinate(i % BOXES_COLUMNS);
+                        consume(WorldInspector::canPlayerMove(
+                            world,
+                            WorldInspector::columnHeight(world, column),
+                            column,
+                            direction));
+                    }
+                };
+            } });
+    }
+
+    benchmarks.push_back(Benchmark{
+        "World::stackHeightUnderBox",
+        QUERY_OPERATIONS,
+        []() -> Run
+        {
+            std::shared_ptr<const Scenario> scenario = makeLoadedScenario();
+            const std::vector<BoxPtr> worldBoxes = boxes(scenario->world());
+            return [scenario, worldBoxes]()
+            {
+                for (std::size_t i = 0; i < QUERY_OPERATIONS && !worldBoxes.empty(); ++i)
+                {
+                    consume(WorldInspector::stackHeightUnderBox(
+                        scenario->world(),
+                        *worldBoxes[i % worldBoxes.size()]));
+                }
+            };
+        } });
+
+    benchmarks.push_back(Benchmark{
+        "World::canDropBox",
+        QUERY_OPERATIONS,
+        []() -> Run
+        {
+            std::shared_ptr<const Scenario> scenario = makeLoadedScenario();
+            const std::vector<BoxPtr> worldBoxes = boxes(scenario->world());
+            return [scenario, worldBoxes]()
+            {
+                for (std::size_t i = 0; i < QUERY_OPERATIONS && !worldBoxes.empty(); ++i)
+                {
+                    consume(WorldInspector::canDropBox(
+                        scenario->world(),
+                        worldBoxes[i % worldBoxes.size()]->id(),
+                        Coordinate(i % BOXES_COLUMNS)));
+                }
+            };
+        } });
+
+    benchmarks.push_back(Benchmark{
+        "Object::column/row",
+        QUERY_OPERATIONS,
+        []() -> Run
+        {
+            std::shared_ptr<const Scenario> scenario = makeLoadedScenario();
+            const std::vector<BoxPtr> worldBoxes = boxes(scenario->world());
+            return [scenario, worldBoxes]()
+            {
+                for (std::size_t i = 0; i < QUERY_OPERATIONS && !worldBoxes.empty(); ++i)
+                {
+                    const Box &box = *worldBoxes[i % worldBoxes.size()];
+                    consume(box.column().value_or(0) + box.row().value_or(0));
+                }
+            };
+        } });
+}
+
+
+void addGraphicsBenchmarks(std::vector<Benchmark> &benchmarks)
+{
+    benchmarks.push_back(Benchmark{
+        "Animator::update",
+        QUERY_OPERATIONS,
+        []() -> Run
+        {
+            std::shared_ptr<Animator> animator = std::make_shared<Animator>(
+                ResourceLoader::instance().textureSize(ResourceLoader::TextureId::Player),
+                PLAYER_TEXTURE_SIZE);
+            animator->setAnimation(AnimationOriented(&ANIMATION_WALK));
+            return [animator]()
+            {
+                for (std::size_t i = 0; i < QUERY_OPERATIONS; ++i)
+                {
+                    consume(animator->update(TICK));
+                }
+            };
+        } });
+
+    benchmarks.push_back(Benchmark{
+        "Text::update",
+        CONSTRUCTION_OPERATIONS,
+        []() -> Run
+        {
+            std::shared_ptr<Text> text = std::make_shared<Text>();
+            return [text]()
+            {
+                // Каждое изменение текста перестраивает вершины символов.
+                for (std::size_t i = 0; i < CONSTRUCTION_OPERATIONS; ++i)
+                {
+                    text->setText(int(i));
+                }
+            };
+        } });
+
+    benchmarks.push_back(Benchmark{
+        "Score construction",
+        CONSTRUCTION_OPERATIONS,
+        []() -> Run
+        {
+            return []()
+            {
+                for (std::size_t i = 0; i < CONSTRUCTION_OPERATIONS; ++i)
+                {
+                    const Score score{ unsigned(i) };
+                }
+            };
+        } });
+}
+
+
+std::vector<Benchmark> makeBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+    addWorldBenchmarks(benchmarks);
+    addQueryBenchmarks(benchmarks);
+    addGraphicsBenchmarks(benchmarks);
+    return benchmarks;
+}
+
+
+/// \return Медиана прогонов по времени.
+Result measure(const Benchmark &benchmark)
+{
+    std::vector<Result> results;
+    for (std::size_t i = 0; i < REPETITIONS; ++i)
+    {
+        const Run run = benchmark.prepare();
+        const PerformanceCounters &counters = PerformanceCounters::thread();
+        const AllocationTracker::Counters allocationsBefore = AllocationTracker::thread();
+        const PerformanceCounters::Values countersBefore = counters.read();
+        const TimePoint start = Clock::now();
+        run();
+        const TimePoint finish = Clock::now();
+        const PerformanceCounters::Values values = counters.read() - countersBefore;
+        const AllocationTracker::Counters allocations =
+            AllocationTracker::thread() - allocationsBefore;
+
+        Result result;
+        result.nanoseconds =
+            std::chrono::duration<double, std::nano>(finish - start).count()
+            / double(benchmark.operations);
+        result.allocations = double(allocations.allocations) / double(benchmark.operations);
+        result.bytes = double(allocations.bytes) / double(benchmark.operations);
+        result.instructionsPerCycle = values.cycles > 0
+            ? double(values.instructions) / double(values.cycles)
+            : 0;
+        result.cacheMisses = double(values.cacheMisses) / double(benchmark.operations);
+        result.branchMisses = double(values.branchMisses) / double(benchmark.operations);
+        results.push_back(result);
+    }
+    std::sort(
+        results.begin(),
+        results.end(),
+        [](const Result &a, const Result &b) { return a.nanoseconds < b.nanoseconds; });
+    return results[results.size() / 2];
+}
+
+
+/*!
+ * Читает базовые результаты. Строка файла: название, время операции
+ * в наносекундах и количество выделений памяти на операцию,
+ * разделённые табуляцией.
+ */
+bool readBaseline(const std::string &path, std::map<std::string, Result> &baseline)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        LOG_ERROR("Failed to open baseline \"" << path << "\".");
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const std::size_t nameEnd = line.find('\t');
+        if (nameEnd == std::string::npos)
+        {
+            continue;
+        }
+        std::istringstream values(line.substr(nameEnd + 1));
+        Result result;
+        if (values >> result.nanoseconds >> result.allocations)
+        {
+            baseline[line.substr(0, nameEnd)] = result;
+        }
+    }
+    return true;
+}
+
+
+bool writeBaseline(
+    const std::string &path,
+    const std::vector<std::pair<std::string, Result>> &results)
+{
+    std::ofstream file(path, std::ios::trunc);
+    for (const auto &[name, result] : results)
+    {
+        file << name << '\t' << result.nanoseconds << '\t' << result.allocations << '\n';
+    }
+    file.close();
+    if (!file)
+    {
+        LOG_ERROR("Failed to write baseline \"" << path << "\".");
+        return false;
+    }
+    return true;
+}
+
+
+/// \return \c true, если результат хуже базового.
+bool compare(std::ostream &stream, const Result &result, const Result &baseline)
+{
+    const double change = baseline.nanoseconds > 0
+        ? result.nanoseconds / baseline.nanoseconds - 1
+        : 0;
+    const bool slower = change > REGRESSION_THRESHOLD;
+    const bool moreAllocations =
+        result.allocations > baseline.allocations + ALLOCATIONS_THRESHOLD;
+    stream << std::showpos << std::setw(VALUE_WIDTH - 1) << change * 100 << '%'
+        << std::noshowpos;
+    if (slower || moreAllocations)
+    {
+        stream << "  REGRESSION";
+        if (moreAllocations)
+        {
+            stream << " (allocations " << baseline.allocations << " -> "
+                << result.allocations << ')';
+        }
+    }
+    return slower || moreAllocations;
+}
+
+
+int usage(const char *executable)
+{
+    std::cerr
+        << "Usage: " << executable
+        << " [--filter <substring>] [--baseline <file>] [--save-baseline <file>]"
+        << " [--perf-counters]\n";
+    return 1;
+}
+
+}
+
+
+int main(int argc, char *argv[])
+{
+    std::string filter;
+    std::optional<std::string> baselinePath;
+    std::optional<std::string> saveBaselinePath;
+    bool performanceCounters = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--perf-counters") == 0)
+        {
+            performanceCounters = true;
+            continue;
+        }
+        if (i + 1 == argc)
+        {
+            return usage(argv[0]);
+        }
+        if (std::strcmp(argv[i], "--filter") == 0)
+        {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--save-baseline") == 0)
+        {
+            saveBaselinePath = argv[++i];
+        }
+        else
+        {
+            return usage(argv[0]);
+        }
+    }
+
+    Log::instance().setMinimumSeverity(Log::Severity::Warning);
+    std::map<std::string, Result> baseline;
+    if (baselinePath.has_value() && !readBaseline(baselinePath.value(), baseline))
+    {
+        return 1;
+    }
+    if (!ResourceLoader::instance().loadImages(argv[0]))
+    {
+        LOG_ERROR("Failed to load resources.");
+        return 1;
+    }
+
+    if (!AllocationTracker::enabled())
+    {
+        LOG_WARNING("Allocation tracking is disabled, allocations are not measured.");
+    }
+    // Измерения выполняются в главном потоке.
+    performanceCounters = performanceCounters && PerformanceCounters::thread().open();
+    std::cout << std::left << std::setw(NAME_WIDTH) << "benchmark" << std::right
+        << std::setw(VALUE_WIDTH) << "ns/op"
+        << std::setw(VALUE_WIDTH) << "allocs/op"
+        << std::setw(VALUE_WIDTH) << "bytes/op";
+    if (performanceCounters)
+    {
+        std::cout << std::setw(VALUE_WIDTH) << "IPC"
+            << std::setw(VALUE_WIDTH) << "cmiss/op"
+            << std::setw(VALUE_WIDTH) << "bmiss/op";
+    }
+    if (!baseline.empty())
+    {
+        std::cout << std::setw(VALUE_WIDTH) << "change";
+    }
+    std::cout << '\n' << std::fixed << std::setprecision(2);
+
+    std::vector<std::pair<std::string, Result>> results;
+    bool regression = false;
+    for (const Benchmark &benchmark : makeBenchmarks())
+    {
+        if (benchmark.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        const Result result = measure(benchmark);
+        results.emplace_back(benchmark.name, result);
+
+        std::cout << std::left << std::setw(NAME_WIDTH) << benchmark.name << std::right
+            << std::setw(VALUE_WIDTH) << result.nanoseconds
+            << std::setw(VALUE_WIDTH) << result.allocations
+            << std::setw(VALUE_WIDTH) << result.bytes;
+        if (performanceCounters)
+        {
+            std::cout << std::setw(VALUE_WIDTH) << result.instructionsPerCycle
+                << std::setw(VALUE_WIDTH) << result.cacheMisses
+                << std::setw(VALUE_WIDTH) << result.branchMisses;
+        }
+        const auto it = baseline.find(benchmark.name);
+        if (it != baseline.cend())
+        {
+            regression = compare(std::cout, result, it->second) || regression;
+        }
+        std::cout << std::endl;
+    }
+
+    if (saveBaselinePath.has_value() && !writeBaseline(saveBaselinePath.value(), results))
+    {
+        return 1;
+    }
+    Log::instance().flush();
+    return regression ? 2 : 0;
+}
@@ -0,0 +1,108 @@
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <game/event_log.h>
+
+
+namespace
+{
+
+/// Название события и его аргументов. Пустое название - аргумент не используется.
+struct EventDescription
+{
+    const char *name;
+    std::array<const char*, 3> arguments;
+};
+
+const std::array<EventDescription, 5> EVENT_DESCRIPTIONS =
+{{
+    { "player_move", { "direction", "row", "column" } },
+    { "box_drop", { "column", "", "box" } },
+    { "box_push", { "direction", "column", "box" } },
+    { "row_blow", { "cranes", "", "score" } },
+    { "game_over", { "", "", "score" } }
+}};
+
+
+const EventDescription* description(EventLog::Type type)
+{
+    const std::size_t index = std::size_t(type);
+    return index < EVENT_DESCRIPTIONS.size() ? &EVENT_DESCRIPTIONS[index] : nullptr;
+}
+
+
+void writeCsv(const EventLog::Record &record)
+{
+    const EventDescription *event = description(record.type);
+    std::cout
+        << record.game << ','
+        << record.tick << ','
+        << (event != nullptr ? event->name : "unknown") << ','
+        << unsigned(record.argument0) << ','
+        << record.argument1 << ','
+        << record.argument2 << '\n';
+}
+
+
+void writeJson(const EventLog::Record &record, bool first)
+{
+    const EventDescription *event = description(record.type);
+    std::cout
+        << (first ? "[\n" : ",\n")
+        << "  {\"game\": " << record.game
+        << ", \"tick\": " << record.tick
+        << ", \"event\": \"" << (event != nullptr ? event->name : "unknown") << '"';
+    const std::array<std::uint32_t, 3> arguments =
+        { record.argument0, record.argument1, record.argument2 };
+    for (std::size_t i = 0; i < arguments.size(); ++i)
+    {
+        const std::string name = event != nullptr
+            ? event->arguments[i]
+            : "argument" + std::to_string(i);
+        if (!name.empty())
+        {
+            std::cout << ", \"" << name << "\": " << arguments[i];
+        }
+    }
+    std::cout << '}';
+}
+
+}
+
+
+int main(int argc, char *argv[])
+{
+    const bool json = argc > 2 && std::strcmp(argv[2], "json") == 0;
+    if (argc < 2 || (argc > 2 && !json && std::strcmp(argv[2], "csv") != 0))
+    {
+        std::cerr << "Usage: " << argv[0] << " <event log> [csv|json]\n";
+        return 1;
+    }
+
+    bool first = true;
+    if (!json)
+    {
+        std::cout << "game,tick,event,argument0,argument1,argument2\n";
+    }
+    const bool ok = readEventLog(
+        argv[1],
+        [json, &first](const EventLog::Record &record)
+        {
+            if (json)
+            {
+                writeJson(record, first);
+            }
+            else
+            {
+                writeCsv(record);
+            }
+            first = false;
+        });
+    if (json)
+    {
+        std::cout << (first ? "[]\n" : "\n]\n");
+    }
+    return ok ? 0 : 1;
+}
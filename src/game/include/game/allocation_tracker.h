@@ -0,0 +1,49 @@
+#pragma once
+
+
+#include <cstdint>
+
+
+/*!
+ * Учёт выделений памяти в куче.
+ * Если определён ALLOCATION_TRACKING_ENABLED (параметр CMake
+ * ALLOCATION_TRACKING), глобальные операторы new и delete заменяются
+ * считающими. Иначе все счётчики равны нулю.
+ */
+class AllocationTracker final
+{
+public:
+    struct Counters
+    {
+        Counters operator-(const Counters &other) const noexcept
+        {
+            return Counters{ allocations - other.allocations, bytes - other.bytes };
+        }
+
+        /// Количество выделений памяти.
+        std::uint64_t allocations{ 0 };
+        /// Количество выделенных байтов.
+        std::uint64_t bytes{ 0 };
+    };
+
+public:
+    AllocationTracker() = delete;
+
+    /// \return \c true, если операторы new и delete заменены.
+    static constexpr bool enabled() noexcept
+    {
+#ifdef ALLOCATION_TRACKING_ENABLED
+        return true;
+#else
+        return false;
+#endif
+    }
+    /// \return Выделения всех потоков с начала работы программы.
+    static Counters total() noexcept;
+    /// \return Выделения вызывающего потока с начала его работы.
+    static Counters thread() noexcept;
+    /// \return Объём памяти, выделенной и ещё не освобождённой, байты.
+    static std::int64_t heapSize() noexcept;
+    /// \return Наибольшее значение heapSize() с начала работы программы.
+    static std::int64_t heapPeakSize() noexcept;
+};
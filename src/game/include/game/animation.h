@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <initializer_list>
 #include <vector>
 
 #include <SFML/Graphics.hpp>
@@ -13,6 +14,9 @@ namespace
 
 /// Длительность отображения одного кадра анимации.
 const Duration ANIMATION_INTERVAL_DEFAULT = std::chrono::milliseconds(300);
+/// Наибольшая длина последовательности анимаций. Память под неё
+/// выделяется при создании аниматора.
+constexpr std::size_t ANIMATION_SEQUENCE_CAPACITY = 2;
 
 }
 
@@ -86,12 +90,12 @@ class Animator final
 {
 public:
     /*!
-     * \param[in] texture Текстура, содержащая спрайты.
+     * \param[in] textureSize Размер текстуры, содержащей спрайты, в пикселях.
      * \param[in] spritesQuantity Размерность текстуры в количестве спрайтов
      * по горизонтали и вертикали.
      */
     explicit Animator(
-        const sf::Texture &texture,
+        const sf::Vector2u &textureSize,
         const sf::Vector2u &spritesQuantity);
     void setAnimation(const AnimationOriented animation);
     /*!
@@ -100,7 +104,9 @@ public:
      * если текущая анимация не последняя.
      * \param[in] sequence Последовательность анимаций.
      */
-    void setAnimationSequence(const std::vector<AnimationOriented> &sequence);
+    void setAnimationSequence(std::initializer_list<AnimationOriented> sequence);
+    /// Возвращает аниматор в состояние только что созданного.
+    void reset();
     bool update(const Duration &elapsed);
     unsigned int currentSpriteIndex() const noexcept;
     const sf::IntRect& rect() const noexcept;
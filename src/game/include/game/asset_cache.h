@@ -0,0 +1,72 @@
+#pragma once
+
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <game/resource_loader.h>
+
+
+/*!
+ * Дисковый кэш декодированных ресурсов: пикселей изображений в формате RGBA
+ * и отсчётов звуков. Позволяет не декодировать PNG и OGG при каждом запуске.
+ * Запись кэша соответствует ресурсу, если совпадают версия формата кэша
+ * и хэш исходного файла ресурса. Иначе запись считается устаревшей
+ * и перезаписывается после декодирования.
+ * Данные хранятся в порядке байтов платформы, поэтому кэш
+ * не предназначен для переноса между машинами.
+ */
+class AssetCache final
+{
+public:
+    /*!
+     * \param[in] directory Каталог кэша. Создаётся при первой записи.
+     */
+    explicit AssetCache(const std::filesystem::path &directory);
+
+    /*!
+     * Вычисляет хэш исходного файла ресурса (FNV-1a, 64 бита).
+     * \param[in] data Содержимое файла.
+     * \param[in] size Размер файла.
+     */
+    static std::uint64_t hash(const std::uint8_t *data, std::size_t size) noexcept;
+
+    /*!
+     * Загружает изображение из кэша.
+     * \param[in] name Имя ресурса.
+     * \param[in] sourceHash Хэш исходного файла ресурса.
+     * \return Пустой указатель, если записи нет или она устарела.
+     */
+    ImagePtr loadImage(const std::string &name, std::uint64_t sourceHash) const;
+    /*!
+     * Загружает звук из кэша. Отсчёты не копируются и остаются
+     * в отображённом в память файле кэша.
+     * \param[in] name Имя ресурса.
+     * \param[in] sourceHash Хэш исходного файла ресурса.
+     * \return Пустой указатель, если записи нет или она устарела.
+     */
+    SoundSamplesPtr loadSound(const std::string &name, std::uint64_t sourceHash) const;
+    /*!
+     * Сохраняет декодированное изображение в кэш.
+     * Ошибка записи не является критической и только протоколируется.
+     */
+    void storeImage(
+        const std::string &name,
+        std::uint64_t sourceHash,
+        const sf::Image &image) const;
+    /*!
+     * Сохраняет декодированный звук в кэш.
+     * Ошибка записи не является критической и только протоколируется.
+     */
+    void storeSound(
+        const std::string &name,
+        std::uint64_t sourceHash,
+        const SoundSamples &sound) const;
+
+private:
+    std::filesystem::path entryPath(const std::string &name) const;
+
+private:
+    std::filesystem::path m_directory;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+
+#include <filesystem>
+#include <string>
+
+
+/*!
+ * Записывает файл целиком через временный файл с последующим переименованием,
+ * так что сбой во время записи не повреждает прежнее содержимое.
+ * \param[in] path Путь к файлу.
+ * \param[in] data Содержимое файла.
+ * \return \c true, если файл записан.
+ */
+bool writeFileAtomically(const std::filesystem::path &path, const std::string &data);
@@ -0,0 +1,115 @@
+#pragma once
+
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <game/clock.h>
+#include <game/replay.h>
+#include <game/world.h>
+
+
+namespace
+{
+
+/// Каталог автосохранений.
+const std::filesystem::path AUTOSAVE_DIR("autosave");
+/// Количество хранимых поколений автосохранения.
+constexpr std::uint64_t AUTOSAVE_GENERATIONS = 3;
+
+}
+
+
+/*!
+ * Автосохранение идущей игры для восстановления после аварийного
+ * завершения.
+ * В игровом потоке копируется только состояние мира (World::makeSnapshot())
+ * и события записи игры, добавленные с прошлого снимка.
+ * Фоновый поток ведёт собственную копию записи игры, переводит снимок
+ * в формат World::save(), сжимает его и записывает во временный файл,
+ * сбрасывает файл на диск и переименовывает в файл очередного поколения.
+ * Хранятся AUTOSAVE_GENERATIONS последних поколений.
+ * Пока объект существует, в каталоге лежит файл-признак работы игры.
+ * Если при запуске этот файл найден, прошлый запуск завершился аварийно.
+ */
+class Autosave final
+{
+public:
+    /*!
+     * \param[in] directory Каталог автосохранений. Создаётся при необходимости.
+     */
+    explicit Autosave(const std::filesystem::path &directory = AUTOSAVE_DIR);
+    ~Autosave();
+    Autosave(const Autosave&) = delete;
+    Autosave& operator=(const Autosave&) = delete;
+
+    /*!
+     * Делает снимок мира, если с прошлого снимка прошло достаточно времени.
+     * \param[in] world Мир идущей игры.
+     * \param[in] elapsed Время, прошедшее с прошлого вызова.
+     */
+    void update(const World &world, const Duration &elapsed);
+    /// Удаляет автосохранения: игра окончена или сохранена иначе.
+    void discard();
+
+    /*!
+     * \param[in] directory Каталог автосохранений.
+     * \return \c true, если прошлый запуск завершился аварийно.
+     */
+    static bool uncleanExit(const std::filesystem::path &directory = AUTOSAVE_DIR);
+    /*!
+     * Читает самое новое неповреждённое автосохранение.
+     * \param[in] directory Каталог автосохранений.
+     * \return Данные, записанные World::save().
+     */
+    static std::optional<std::string> readNewest(
+        const std::filesystem::path &directory = AUTOSAVE_DIR);
+
+private:
+    /// Снимок, ожидающий записи.
+    struct Pending
+    {
+        World::Snapshot world;
+        /*!
+         * События записи игры, не переданные фоновому потоку.
+         * Если \c restart, запись содержит всю игру.
+         */
+        Replay replay;
+        /// Номер первого интервала в replay.intervals в полной записи игры.
+        std::size_t firstInterval{ 0 };
+        /// Снимок относится к новой игре.
+        bool restart{ true };
+    };
+
+private:
+    void run();
+    void write(const Pending &pending);
+    void removeGenerations(std::uint64_t newestGeneration);
+
+private:
+    std::filesystem::path m_directory;
+    /// Время с прошлого снимка.
+    Duration m_sinceSnapshot{ 0 };
+    /// Номер игры, события которой переданы фоновому потоку.
+    std::uint64_t m_gameId{ 0 };
+    /// Количество переданных событий записи игры.
+    std::size_t m_sentInputs{ 0 };
+    std::size_t m_sentIntervals{ 0 };
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::optional<Pending> m_pending;
+    bool m_discardRequested{ false };
+    bool m_stopping{ false };
+
+    // Используется только фоновым потоком.
+    std::uint64_t m_generation{ 0 };
+    /// Полная запись игры, собранная из переданных событий.
+    Replay m_replay;
+};
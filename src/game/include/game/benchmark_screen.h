@@ -0,0 +1,68 @@
+#pragma once
+
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/signals2.hpp>
+
+#include <SFML/Graphics.hpp>
+
+#include <game/bot.h>
+#include <game/screen.h>
+#include <game/world.h>
+
+
+/// Воспроизводимая игра для измерения длительности кадров.
+struct BenchmarkScenario
+{
+    std::string name;
+    std::string description;
+    /// Номер начального положения из INITIAL_POSITIONS.
+    unsigned int positionIndex;
+    std::uint8_t cranesQuantity;
+    /// Начальное значение генератора случайных чисел мира и бота.
+    std::uint32_t seed;
+};
+
+/// Встроенные сценарии измерения.
+extern const std::vector<BenchmarkScenario> BENCHMARK_SCENARIOS;
+
+
+/*!
+ * Экран игры бота по сценарию измерения.
+ * Мир обновляется с фиксированным интервалом независимо от длительности
+ * кадра, а бот с начальным значением сценария нажимает одни и те же
+ * клавиши, поэтому каждый запуск отрисовывает одинаковые кадры.
+ * Оконченная игра сразу начинается заново с теми же условиями.
+ */
+class BenchmarkScreen final : public Screen
+{
+public:
+    using Signal = boost::signals2::signal<void()>;
+    using Slot = Signal::slot_type;
+
+public:
+    explicit BenchmarkScreen(const BenchmarkScenario &scenario);
+
+    void update(const Duration &elapsed) override;
+    bool handleKeyPressed(const sf::Keyboard::Key key) override;
+    void draw(
+        sf::RenderTarget &target,
+        sf::RenderStates states) const override;
+
+    boost::signals2::connection connectClose(const Slot &slot);
+    /// \return Количество вызовов отрисовки, выполненных последним draw().
+    std::size_t drawCalls() const noexcept;
+
+private:
+    void start();
+
+private:
+    const BenchmarkScenario m_scenario;
+    Signal m_signalClose;
+    World m_world;
+    RandomBot m_bot;
+};
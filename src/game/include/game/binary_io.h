@@ -0,0 +1,176 @@
+#pragma once
+
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+
+/*!
+ * Запись значений в двоичный поток.
+ * Целые числа записываются в порядке little-endian независимо от платформы,
+ * числа с плавающей точкой - побитово.
+ */
+class BinaryWriter final
+{
+public:
+    explicit BinaryWriter(std::ostream &stream)
+        : m_stream(stream)
+    {
+    }
+
+    template<typename T>
+    void write(T value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+        writeBytes(toUnsigned(value));
+    }
+
+    bool good() const
+    {
+        return m_stream.good();
+    }
+
+private:
+    template<typename U>
+    void writeBytes(U value)
+    {
+        char bytes[sizeof(U)];
+        for (std::size_t i = 0; i < sizeof(U); ++i)
+        {
+            bytes[i] = char(std::uint8_t(value >> (8 * i)));
+        }
+        m_stream.write(bytes, sizeof(U));
+    }
+
+    template<typename T>
+    static auto toUnsigned(T value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return std::uint8_t(value);
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            using U = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+            static_assert(sizeof(T) == sizeof(U));
+            U result;
+            std::memcpy(&result, &value, sizeof(T));
+            return result;
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            return std::make_unsigned_t<std::underlying_type_t<T>>(value);
+        }
+        else
+        {
+            return std::make_unsigned_t<T>(value);
+        }
+    }
+
+private:
+    std::ostream &m_stream;
+};
+
+
+/*!
+ * Чтение значений, записанных BinaryWriter.
+ * После первой ошибки чтения все последующие чтения также завершаются
+ * ошибкой, поэтому результат достаточно проверить один раз в конце.
+ */
+class BinaryReader final
+{
+public:
+    explicit BinaryReader(std::istream &stream)
+        : m_stream(stream)
+    {
+    }
+
+    template<typename T>
+    bool read(T &value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            std::uint8_t byte{ 0 };
+            const bool result = readBytes(byte);
+            value = byte != 0;
+            return result;
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            using U = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+            U bits{ 0 };
+            const bool result = readBytes(bits);
+            std::memcpy(&value, &bits, sizeof(T));
+            return result;
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            std::make_unsigned_t<std::underlying_type_t<T>> raw{ 0 };
+            const bool result = readBytes(raw);
+            value = T(raw);
+            return result;
+        }
+        else
+        {
+            std::make_unsigned_t<T> raw{ 0 };
+            const bool result = readBytes(raw);
+            value = T(raw);
+            return result;
+        }
+    }
+
+    bool good() const
+    {
+        return m_stream.good();
+    }
+
+private:
+    template<typename U>
+    bool readBytes(U &value)
+    {
+        char bytes[sizeof(U)];
+        if (!m_stream.read(bytes, sizeof(U)))
+        {
+            return false;
+        }
+        value = 0;
+        for (std::size_t i = 0; i < sizeof(U); ++i)
+        {
+            value |= U(std::uint8_t(bytes[i])) << (8 * i);
+        }
+        return true;
+    }
+
+private:
+    std::istream &m_stream;
+};
+
+
+/*!
+ * Читает целое число, записанное BinaryWriter, из памяти.
+ * \param[in,out] cursor Начало числа. Сдвигается за прочитанное число.
+ * \param[in] end Конец доступной памяти.
+ * \param[out] value Прочитанное число.
+ * \return \c false, если до конца памяти недостаточно байтов.
+ */
+template<typename T>
+bool readLittleEndian(const std::uint8_t *&cursor, const std::uint8_t *end, T &value)
+{
+    static_assert(std::is_integral_v<T>);
+    if (std::size_t(end - cursor) < sizeof(T))
+    {
+        return false;
+    }
+    std::make_unsigned_t<T> raw{ 0 };
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        raw |= std::make_unsigned_t<T>(cursor[i]) << (8 * i);
+    }
+    value = T(raw);
+    cursor += sizeof(T);
+    return true;
+}
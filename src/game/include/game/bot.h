@@ -0,0 +1,42 @@
+#pragma once
+
+
+#include <cstdint>
+#include <optional>
+#include <random>
+
+#include <SFML/Window.hpp>
+
+#include <game/clock.h>
+
+
+class World;
+
+
+/*!
+ * Бот, управляющий игроком случайными нажатиями клавиш.
+ * Нажимает клавиши через World::handleKeyPressed(), как это делает
+ * игрок, поэтому его действия попадают в запись игры.
+ */
+class RandomBot final
+{
+public:
+    /*!
+     * \param[in] seed Начальное значение генератора случайных чисел.
+     */
+    explicit RandomBot(std::uint32_t seed);
+
+    /*!
+     * Принимает решение и нажимает клавиши перед обновлением мира.
+     * \param[in] world Игровой мир, которым управляет бот.
+     * \param[in] elapsed Время, прошедшее с прошлого решения.
+     */
+    void update(World &world, const Duration &elapsed);
+
+private:
+    std::mt19937 m_randomEngine;
+    /// Время до следующего решения.
+    Duration m_delay{ 0 };
+    /// Удерживаемая клавиша.
+    std::optional<sf::Keyboard::Key> m_key;
+};
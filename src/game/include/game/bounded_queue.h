@@ -0,0 +1,85 @@
+#pragma once
+
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+
+/*!
+ * Очередь ограниченной ёмкости для передачи данных между потоками.
+ * Поставщик блокируется, пока очередь заполнена, что не даёт ему
+ * уйти далеко вперёд от потребителей.
+ */
+template<typename T>
+class BoundedQueue final
+{
+public:
+    explicit BoundedQueue(std::size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    /*!
+     * Добавляет элемент в очередь, ожидая появления свободного места.
+     * \return \c false, если очередь закрыта.
+     */
+    bool push(T value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(
+            lock,
+            [this]() { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed)
+        {
+            return false;
+        }
+        m_items.push_back(std::move(value));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    /*!
+     * Извлекает элемент из очереди, ожидая его появления.
+     * \return Пустое значение, если очередь закрыта и в ней не осталось
+     * элементов.
+     */
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(
+            lock,
+            [this]() { return m_closed || !m_items.empty(); });
+        if (m_items.empty())
+        {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(m_items.front()));
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return value;
+    }
+
+    /// Закрывает очередь. Оставшиеся элементы можно извлечь.
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+private:
+    const std::size_t m_capacity;
+    std::deque<T> m_items;
+    bool m_closed{ false };
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
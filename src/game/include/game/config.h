@@ -13,8 +13,24 @@ constexpr std::uint8_t MAX_INITIAL_CRANES_QUANTITY = 3;
 }
 
 
+/*!
+ * Настройки игры.
+ * Изменение любого параметра отмечает настройки как изменённые,
+ * что служит сигналом для их сохранения (см. ConfigWriter).
+ */
 class Config final
 {
+public:
+    struct Values
+    {
+        std::uint8_t cranesQuantity{ 1 };
+        bool sound{ true };
+        /// Масштаб увеличения кадра игрового мира. 0 - наибольший возможный.
+        unsigned int screenScale{ 0 };
+        /// Сохранять запись каждой завершённой игры.
+        bool recordReplays{ true };
+    };
+
 public:
     /*!
      * Singleton instance accessor.
@@ -22,6 +38,47 @@ public:
      */
     static Config& instance();
 
+    const Values& values() const noexcept
+    {
+        return m_values;
+    }
+    /*!
+     * Заменяет все параметры.
+     * \param[in] values Новые значения параметров.
+     */
+    void setValues(const Values &values);
+
+    std::uint8_t cranesQuantity() const noexcept
+    {
+        return m_values.cranesQuantity;
+    }
+    void setCranesQuantity(std::uint8_t value);
+    bool sound() const noexcept
+    {
+        return m_values.sound;
+    }
+    void setSound(bool value);
+    unsigned int screenScale() const noexcept
+    {
+        return m_values.screenScale;
+    }
+    void setScreenScale(unsigned int value);
+    bool recordReplays() const noexcept
+    {
+        return m_values.recordReplays;
+    }
+    void setRecordReplays(bool value);
+
+    /// \return \c true, если параметры изменены после последнего сохранения.
+    bool dirty() const noexcept
+    {
+        return m_dirty;
+    }
+    void setDirty(bool value) noexcept
+    {
+        m_dirty = value;
+    }
+
 private:
     // Singleton part.
     Config() = default;
@@ -31,8 +88,18 @@ private:
     Config& operator=(Config&&) = delete;
     Config& operator=(const Config&) = delete;
 
-public:
-    std::uint8_t cranesQuantity{ 1 };
-    bool sound{ true };
-    unsigned int highScore{ 0 };
+private:
+    template<typename T>
+    void set(T &field, T value)
+    {
+        if (field != value)
+        {
+            field = value;
+            m_dirty = true;
+        }
+    }
+
+private:
+    Values m_values;
+    bool m_dirty{ false };
 };
@@ -0,0 +1,45 @@
+#pragma once
+
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <game/config.h>
+
+
+/*!
+ * Сохраняет изменённые настройки в фоновом потоке.
+ * Изменения, сделанные одно за другим, объединяются: файл записывается
+ * после паузы в изменениях, и только с последними значениями.
+ * При уничтожении несохранённые изменения записываются.
+ */
+class ConfigWriter final
+{
+public:
+    ConfigWriter();
+    ~ConfigWriter();
+    ConfigWriter(const ConfigWriter&) = delete;
+    ConfigWriter& operator=(const ConfigWriter&) = delete;
+
+    /*!
+     * Передаёт настройки фоновому потоку, если они изменены.
+     * Вызывается в потоке, изменяющем настройки.
+     */
+    void update();
+
+private:
+    void run();
+
+private:
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    /// Настройки, ожидающие записи.
+    std::optional<Config::Values> m_pending;
+    /// Количество переданных изменений.
+    std::uint64_t m_changesQuantity{ 0 };
+    bool m_stopping{ false };
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+namespace
+{
+
+/// Количество записей в буфере потока. Заполненный буфер
+/// записывается в файл одним блоком.
+constexpr std::size_t EVENT_LOG_BLOCK_RECORDS = 4096;
+
+}
+
+
+/*!
+ * Двоичный журнал игровых событий для сбора статистики игр ботов.
+ * Записи имеют фиксированный размер и накапливаются в буфере потока,
+ * в котором возникли. Буфер записывается в файл блоком, когда заполнен,
+ * когда с прошлой записи прошло больше секунды, а также при завершении
+ * потока и закрытии журнала.
+ * Формат файла (целые числа в порядке little-endian):
+ * - сигнатура "SKEV" (4 байта), версия формата (2 байта),
+ *   размер записи (2 байта);
+ * - блоки: количество записей (4 байта), записи.
+ * Запись: номер игры (8 байт), номер обновления мира (4 байта),
+ * тип события (1 байт), аргументы (1, 2 и 4 байта).
+ */
+class EventLog final
+{
+public:
+    enum class Type : std::uint8_t
+    {
+        /// Игрок начал движение. Аргументы: направление, ряд, колонка.
+        PlayerMove,
+        /// Кран сбросил ящик. Аргументы: колонка, -, идентификатор ящика.
+        BoxDrop,
+        /// Игрок толкнул ящик. Аргументы: направление, колонка,
+        /// идентификатор ящика.
+        BoxPush,
+        /// Нижний ряд заполнен и взрывается. Аргументы: количество кранов,
+        /// -, счёт.
+        RowBlow,
+        /// Игра окончена. Аргументы: -, -, счёт.
+        GameOver
+    };
+
+    struct Record
+    {
+        std::uint64_t game{ 0 };
+        std::uint32_t tick{ 0 };
+        Type type{ Type::PlayerMove };
+        std::uint8_t argument0{ 0 };
+        std::uint16_t argument1{ 0 };
+        std::uint32_t argument2{ 0 };
+    };
+
+    /// Размер записи в файле.
+    static constexpr std::uint16_t RECORD_SIZE = 20;
+
+public:
+    /*!
+     * Singleton instance accessor.
+     * \return The reference to an instance of this class.
+     */
+    static EventLog& instance();
+
+    /*!
+     * Открывает файл журнала и включает запись событий.
+     * \param[in] path Путь к файлу журнала.
+     * \return \c true, если файл открыт.
+     */
+    bool open(const std::filesystem::path &path);
+    /*!
+     * Записывает буфер вызывающего потока и закрывает журнал.
+     * Буферы других потоков должны быть к этому моменту записаны,
+     * то есть потоки должны быть завершены.
+     */
+    void close();
+    bool enabled() const noexcept
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+    /// \return Новый номер игры для записей журнала.
+    std::uint64_t newGame() noexcept;
+    /*!
+     * Добавляет событие в буфер вызывающего потока.
+     * Если журнал закрыт, ничего не делает.
+     */
+    void write(const Record &record)
+    {
+        if (enabled())
+        {
+            append(record);
+        }
+    }
+
+private:
+    class ThreadBuffer;
+
+private:
+    // Singleton part.
+    EventLog() = default;
+    ~EventLog();
+    EventLog(const EventLog&) = delete;
+    EventLog(EventLog&&) = delete;
+    EventLog& operator=(EventLog&&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+private:
+    /// \return Буфер записей вызывающего потока.
+    static ThreadBuffer& threadBuffer();
+    void append(const Record &record);
+    void writeBlock(const Record *records, std::size_t quantity);
+
+private:
+    std::atomic<bool> m_enabled{ false };
+    std::atomic<std::uint64_t> m_gamesQuantity{ 0 };
+    std::mutex m_mutex;
+    std::ofstream m_file;
+    /// Закодированный блок записей.
+    std::vector<char> m_block;
+};
+
+
+/*!
+ * Читает журнал событий.
+ * \param[in] path Путь к файлу журнала.
+ * \param[in] callback Функция, вызываемая для каждой записи.
+ * \return \c false, если файл не является журналом событий или повреждён.
+ */
+bool readEventLog(
+    const std::filesystem::path &path,
+    const std::function<void(const EventLog::Record&)> &callback);
@@ -15,19 +15,48 @@
 
 #include <memory>
 #include <optional>
+#include <string>
 
+#include <game/autosave.h>
+#include <game/config_writer.h>
 #include <game/menu_screen.h>
 #include <game/window.h>
 #include <game/screen_debug.h>
 
 
+class BenchmarkScreen;
+struct BenchmarkScenario;
+
+
 class Game final
 {
 public:
     explicit Game();
 
+    /*!
+     * Запускает фоновую загрузку ресурсов.
+     * Экраны, которым нужны ресурсы, создаются по окончании загрузки.
+     */
     bool init();
     void start(const std::optional<unsigned int> &position = std::nullopt);
+    /*!
+     * Запускает наблюдение за одновременными играми ботов.
+     * \param[in] worldsQuantity Количество игр.
+     */
+    void startSpectator(std::size_t worldsQuantity);
+    /*!
+     * Запускает игру бота по сценарию измерения длительности кадров.
+     * Частота кадров не ограничивается. Ресурсы должны быть загружены.
+     * \param[in] scenario Сценарий.
+     * \return Экран игры.
+     */
+    std::shared_ptr<const BenchmarkScreen> startBenchmark(const BenchmarkScenario &scenario);
+    /*!
+     * Предлагает продолжить игру, восстановленную после аварийного
+     * завершения. Игра продолжается из начального меню.
+     * \param[in] snapshot Данные, записанные World::save().
+     */
+    void offerRecovery(std::string snapshot);
     void handleInput();
     void update();
     void render();
@@ -36,13 +65,27 @@ public:
 
 private:
     void setup();
+    /*!
+     * Вызывает функцию, когда все ресурсы загружены. До этого момента
+     * отображается экран загрузки.
+     * \param[in] function Вызываемая функция.
+     */
+    void whenLoaded(const std::function<void()> &function);
+    void onLoaded(bool success, const std::function<void()> &function);
     std::shared_ptr<MenuScreen> makeStartScreen();
-    std::shared_ptr<World> makeWorldScreen();
+    /*!
+     * \param[in] resume Продолжить сохранённую игру. Если её не удалось
+     * прочитать, начинается новая игра.
+     */
+    std::shared_ptr<World> makeWorldScreen(bool resume);
+    void saveWorld(const World &world);
+    bool restoreWorld(World &world);
     void onWindowResized(const sf::Vector2u &size);
     void onKeyPressed(const sf::Event::KeyEvent &key);
     void onKeyReleased(const sf::Event::KeyEvent &key);
-    void onMenuScreenClosed(bool startGame);
-    void onWorldScreenClosed();
+    void onMenuScreenClosed(MenuScreen::Result result);
+    void onWorldScreenClosed(const World &world);
+    void onWorldGameOver(const World &world);
     void exit();
 
 private:
@@ -59,4 +102,12 @@ private:
     Duration m_elapsed;
 
     std::optional<unsigned int> m_initialPosition;
+
+    /// Идущая игра, которая автосохраняется.
+    std::shared_ptr<World> m_world;
+    /// Игра, восстановленная после аварийного завершения.
+    std::optional<std::string> m_recovery;
+    Autosave m_autosave;
+
+    ConfigWriter m_configWriter;
 };
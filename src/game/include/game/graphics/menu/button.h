@@ -1,8 +1,6 @@
 #pragma once
 
 
-#include <list>
-
 #include <game/graphics/text.h>
 
 
@@ -34,6 +32,6 @@ private:
 
 private:
     sf::Vector2f m_position;
-    std::list<sf::RectangleShape> m_background;
+    const sf::VertexArray *m_background{ nullptr };
     Text m_text;
 };
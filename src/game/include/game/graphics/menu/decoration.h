@@ -0,0 +1,40 @@
+#pragma once
+
+
+#include <cstdint>
+
+#include <SFML/Graphics.hpp>
+
+
+/// Элементы оформления виджетов меню.
+enum class Decoration : std::uint8_t
+{
+    /// Квадратная рамка чекбокса.
+    CheckboxFrame,
+    /// Круглая рамка радио-кнопки.
+    RadioButtonFrame,
+    /// Горизонтальная пунктирная линия пустого пункта меню.
+    DottedLine,
+    /// Галочка чекбокса.
+    CheckMark,
+    /// Кружок радио-кнопки.
+    RadioMark,
+    /// Фон активной кнопки.
+    ButtonEnabled,
+    /// Фон неактивной кнопки, заполненный в шахматном порядке.
+    ButtonDisabled,
+    /// Рамка меню. Фон рамки всегда имеет цвет BACKGROUND_COLOR.
+    MenuFrame
+};
+
+
+/*!
+ * Возвращает элемент оформления, собранный в массив треугольников.
+ * Массив строится при первом обращении и далее берётся из кэша, поэтому
+ * ссылка остаётся действительной до завершения программы.
+ * \param[in] type Элемент оформления.
+ * \param[in] color Цвет элемента.
+ * \return Массив вершин в системе координат с началом в левом верхнем углу
+ * элемента. Для рамки меню - в левом верхнем углу FRAME_POSITION.
+ */
+const sf::VertexArray& decoration(Decoration type, const sf::Color &color);
@@ -57,5 +57,6 @@ protected:
     boost::signals2::connection m_connectionLeft;
     boost::signals2::connection m_connectionRight;
 
-    std::list<sf::RectangleShape> m_frame;
+    /// Рамка меню. Отсутствует у меню без рамки.
+    const sf::VertexArray *m_frame{ nullptr };
 };
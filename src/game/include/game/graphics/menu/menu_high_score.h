@@ -1,11 +1,23 @@
 #pragma once
 
 
+#include <array>
 #include <optional>
+#include <vector>
 
+#include <game/leaderboard.h>
 #include <game/graphics/menu/menu.h>
 
 
+namespace
+{
+
+/// Количество строк таблицы рекордов.
+constexpr std::size_t HIGH_SCORE_ROWS_QUANTITY = 3;
+
+}
+
+
 class MenuHighScore final : public Menu
 {
 public:
@@ -17,17 +29,29 @@ public:
         sf::RenderTarget &target,
         sf::RenderStates states) const override;
 
-    unsigned int highScore() const noexcept;
-    void setHighScore(unsigned int value);
+    /*!
+     * Задаёт лучшие результаты.
+     * \param[in] entries Результаты в порядке убывания. Отображаются
+     * первые HIGH_SCORE_ROWS_QUANTITY.
+     */
+    void setEntries(const std::vector<Leaderboard::Entry> &entries);
+    /// \return \c true, если пользователь удалил рекорды.
+    bool cleared() const noexcept;
 
 private:
-    void setText(unsigned int value);
+    void setText();
     void setSecretText();
+    /// Выводит сообщение по центру средней строки.
+    void setMessage(const std::u32string &text);
     void setup();
     void deleteHighScore();
 
 private:
-    unsigned int m_highScore{ 0 };
-    Text m_text;
+    std::vector<Leaderboard::Entry> m_entries;
+    bool m_cleared{ false };
+    /// Строки с местом и именем игрока либо сообщением.
+    std::array<Text, HIGH_SCORE_ROWS_QUANTITY> m_rows;
+    /// Счёт, выровненный по правому краю строки.
+    std::array<Text, HIGH_SCORE_ROWS_QUANTITY> m_scores;
     std::optional<Duration> m_secretTextVisibleDuration;
 };
@@ -2,11 +2,11 @@
 
 
 #include <cstdint>
-#include <list>
 
 #include <boost/signals2.hpp>
 
 #include <game/graphics/text.h>
+#include <game/graphics/menu/decoration.h>
 
 
 struct Action
@@ -49,7 +49,7 @@ public:
 
 private:
     void update();
-    void makeCheckMark();
+    const sf::Color& color() const noexcept;
 
 private:
     Text m_text;
@@ -57,8 +57,10 @@ private:
     bool m_checked{ false };
     bool m_selected{ false };
     sf::Vector2f m_position;
-    std::list<sf::RectangleShape> m_decoration;
-    std::list<sf::RectangleShape> m_checkMark;
+    /// Рамка или пунктир, зависящие от типа пункта.
+    const sf::VertexArray *m_decoration{ nullptr };
+    /// Галочка или кружок отмеченного пункта.
+    const sf::VertexArray *m_checkMark{ nullptr };
     Action m_actionLeft;
     Action m_actionRight;
 };
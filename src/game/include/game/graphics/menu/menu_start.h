@@ -12,6 +12,11 @@ public:
 
     boost::signals2::connection connectStart(const Slot &slot);
     boost::signals2::connection connectOptions(const Slot &slot);
+    /*!
+     * Заменяет начало игры продолжением сохранённой игры.
+     * \param[in] value Есть сохранённая игра.
+     */
+    void setResumable(bool value);
 
 private:
     void setup();
@@ -22,25 +22,45 @@ public:
     using MoveFinishedCallback = std::function<void(Id)>;
 
 public:
+    /// Количество вариантов внешнего вида покоящегося ящика.
+    static std::size_t restStylesQuantity() noexcept;
+
+public:
+    /*!
+     * \param[in] restStyle Номер варианта внешнего вида покоящегося ящика,
+     * меньший restStylesQuantity().
+     */
     explicit Box(
+        std::size_t restStyle,
         const MoveStartedCallback &moveStartedCallback,
         const MoveFinishedCallback &moveFinishedCallback);
     virtual ~Box() = default;
 
+    /*!
+     * Готовит ящик к повторному использованию: ящик становится таким же,
+     * как только что созданный, с новым идентификатором.
+     * \param[in] restStyle Номер варианта внешнего вида покоящегося ящика,
+     * меньший restStylesQuantity().
+     */
+    void recycle(std::size_t restStyle);
     void update(const Duration &elapsed) override;
+    std::size_t restStyle() const noexcept;
     void move(Direction direction);
     bool blow();
     bool isBlowing() const noexcept;
     bool isBlowed() const noexcept;
+    void save(BinaryWriter &writer) const override;
+    bool restore(BinaryReader &reader) override;
 
 protected:
     void moveStarted() override;
     void moveFinished() override;
 
 private:
-    void init();
+    void init(std::size_t restStyle);
 
 private:
+    std::size_t m_restStyle;
     std::optional<Duration> m_blowDuration;
     MoveStartedCallback m_moveStartedCallback;
     MoveFinishedCallback m_moveFinishedCallback;
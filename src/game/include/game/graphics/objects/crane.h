@@ -24,6 +24,9 @@ public:
     explicit Crane();
     virtual ~Crane() = default;
 
+    /// Готовит кран к повторному использованию: кран становится таким же,
+    /// как только что созданный, с новым идентификатором.
+    void recycle();
     void update(const Duration &elapsed) override;
 
     int width() const noexcept;
@@ -54,6 +57,10 @@ public:
      */
     bool readyToReset() const noexcept;
 
+    /// Идентификатор удерживаемого ящика записывается как есть.
+    void save(BinaryWriter &writer) const override;
+    bool restore(BinaryReader &reader) override;
+
 protected:
     void moveFinished() override;
 
@@ -65,7 +72,7 @@ private:
     bool m_left{ true };
     bool m_readyToReset{ false };
     Id m_boxId{ NULL_ID };
-    Coordinate m_dropColumn;
+    Coordinate m_dropColumn{ 0 };
 };
 
 using CranePtr = std::shared_ptr<Crane>;
@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <initializer_list>
 #include <memory>
 #include <optional>
 
@@ -23,6 +24,10 @@ constexpr float SPEED = 1.5 * BOX_SIZE;
 using Coordinate = unsigned int;
 
 
+class BinaryReader;
+class BinaryWriter;
+
+
 struct Coordinates
 {
     std::optional<Coordinate> row;
@@ -58,15 +63,35 @@ public:
      */
     void normalizePosition(bool horizontal, bool vertical);
     void setAnimation(const AnimationOriented &animation);
-    void setAnimationSequence(const std::vector<AnimationOriented> &ids);
+    void setAnimationSequence(std::initializer_list<AnimationOriented> ids);
+    /*!
+     * Записывает положение и движение объекта.
+     * Идентификатор не записывается: восстановленный объект
+     * получает новый идентификатор.
+     * \param[in] writer Получатель данных.
+     */
+    virtual void save(BinaryWriter &writer) const;
+    /*!
+     * Восстанавливает состояние, записанное save().
+     * \param[in] reader Источник данных.
+     * \return \c false, если данных недостаточно.
+     */
+    virtual bool restore(BinaryReader &reader);
 
 protected:
     void move(const Duration &elapsed);
     virtual void moveStarted();
     virtual void moveFinished();
+    /*!
+     * Возвращает объект в положение и движение только что созданного
+     * и назначает ему новый идентификатор, чтобы использовать объект
+     * повторно без выделения памяти.
+     * Текстура, цвет и выделенная под анимацию память сохраняются.
+     */
+    void reset();
 
 protected:
-    const Id m_id;
+    Id m_id;
 
     std::unique_ptr<Animator> m_animator;
     std::vector<AnimationOriented> m_animationIds;
@@ -36,7 +36,13 @@ public:
     Direction direction() const noexcept;
     void idle();
     bool alive() const noexcept;
-    void setAlive(bool alive);
+    /*!
+     * \param[in] alive Признак того, что игрок жив.
+     * \param[in] fallLeft Направление падения погибшего игрока.
+     */
+    void setAlive(bool alive, bool fallLeft = false);
+    void save(BinaryWriter &writer) const override;
+    bool restore(BinaryReader &reader) override;
 
 protected:
     void moveFinished() override;
@@ -52,5 +58,7 @@ private:
     Direction m_direction{ Direction::None };
     bool m_lookLeft{ true };
     bool m_alive{ true };
+    /// Игрок толкает ящик.
+    bool m_push{ false };
     MoveFinishedCallback m_moveFinishedCallback;
 };
@@ -17,6 +17,9 @@ public:
     void draw(
         sf::RenderTarget &target,
         sf::RenderStates states) const override;
+    void drawSprites(SpriteSink &sink) const;
+    /// \return Количество вызовов отрисовки, выполняемых draw().
+    std::size_t drawCalls() const noexcept;
     void update(const Duration &elapsed);
     void setFramePosition(const sf::Vector2f &position);
     void addHourglass(const sf::Vector2f &position);
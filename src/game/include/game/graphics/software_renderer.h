@@ -0,0 +1,118 @@
+#pragma once
+
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <game/graphics/sprite_sink.h>
+#include <game/resource_loader.h>
+
+
+class World;
+
+
+/*!
+ * Программный растеризатор кадра игрового мира.
+ * Рисует ту же сцену, что и World::draw(), в буфер, предоставленный
+ * вызывающей стороной, без обращения к видеокарте. Достаточно
+ * изображений текстур, сами текстуры и контекст OpenGL не нужны. Смешивание повторяет
+ * формулу sf::BlendAlpha, поэтому кадр совпадает с кадром,
+ * нарисованным SFML в текстуру размера SCREEN_SIZE.
+ */
+class SoftwareRenderer final : public SpriteSink
+{
+public:
+    enum class PixelFormat : std::uint8_t
+    {
+        /// 4 байта на пиксель: красный, зелёный, синий, альфа.
+        Rgba,
+        /// 1 байт на пиксель: яркость.
+        Gray
+    };
+
+public:
+    /*!
+     * Размер буфера кадра в байтах.
+     * \param[in] format Формат пикселей.
+     */
+    static std::size_t frameSize(PixelFormat format) noexcept;
+
+public:
+    /*!
+     * Запоминает изображения всех загруженных текстур.
+     * Изображения должны быть загружены до создания растеризатора
+     * (ResourceLoader::loadImages() или ResourceLoader::load()).
+     */
+    explicit SoftwareRenderer();
+
+    /*!
+     * Рисует кадр игрового мира.
+     * \param[in] world Игровой мир.
+     * \param[out] buffer Буфер размером не менее frameSize(format) байт.
+     * Строки пикселей идут сверху вниз без выравнивания.
+     * \param[in] format Формат пикселей буфера.
+     */
+    void render(
+        const World &world,
+        std::uint8_t *buffer,
+        PixelFormat format = PixelFormat::Rgba);
+
+    void drawQuad(
+        ResourceLoader::TextureId texture,
+        const sf::IntRect &rect,
+        const sf::Vector2f &position,
+        const sf::Color &color) override;
+
+private:
+    /// Непрерывный участок строки листа спрайтов.
+    struct Run
+    {
+        std::uint16_t begin;
+        std::uint16_t end;
+        /// Все пиксели участка непрозрачны и копируются без смешивания.
+        bool opaque;
+    };
+
+    /// Лист спрайтов, заранее умноженный на цвет.
+    struct Sheet
+    {
+        sf::Vector2u size;
+        /// Пиксели в формате RGBA.
+        std::vector<std::uint8_t> pixels;
+        /// Участки каждой строки, содержащие видимые пиксели.
+        std::vector<Run> runs;
+        /// Индекс первого участка каждой строки в runs, size.y + 1 элементов.
+        std::vector<std::size_t> rowRuns;
+    };
+
+    /// Текстура, цвет и признак отражения по горизонтали.
+    using SheetKey = std::tuple<ResourceLoader::TextureId, sf::Uint32, bool>;
+
+private:
+    const Sheet* sheet(
+        ResourceLoader::TextureId texture,
+        const sf::Color &color,
+        bool mirrored);
+    void blitRow(
+        const Sheet &sheet,
+        unsigned int sheetRow,
+        int sheetColumn,
+        int width,
+        int x,
+        int y);
+
+private:
+    /// Декодированные изображения текстур.
+    std::map<ResourceLoader::TextureId, ImagePtr> m_images;
+    std::map<SheetKey, Sheet> m_sheets;
+    /// Строка кадра, залитая цветом фона.
+    std::vector<std::uint8_t> m_clearRow;
+    /// Буфер кадра в формате RGBA, в который ведётся отрисовка.
+    std::uint8_t *m_frame{ nullptr };
+    /// Промежуточный буфер для форматов, отличных от RGBA.
+    std::vector<std::uint8_t> m_frameRgba;
+};
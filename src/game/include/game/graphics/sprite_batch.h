@@ -0,0 +1,57 @@
+#pragma once
+
+
+#include <cstddef>
+#include <map>
+
+#include <SFML/Graphics.hpp>
+
+#include <game/graphics/sprite_sink.h>
+
+
+/*!
+ * Накопитель спрайтов для вывода одним вызовом отрисовки.
+ * Все изображения текстур ResourceLoader копируются в единый атлас, а каждый спрайт
+ * превращается в два треугольника общего массива вершин. Порядок вывода
+ * спрайтов сохраняется, поэтому сцены, выведенные друг за другом,
+ * перекрываются так же, как при отрисовке по отдельности.
+ */
+class SpriteBatch final : public SpriteSink, public sf::Drawable
+{
+public:
+    /*!
+     * Собирает атлас из изображений, загруженных ResourceLoader.
+     * Ресурсы должны быть загружены до создания накопителя.
+     */
+    explicit SpriteBatch();
+
+    using SpriteSink::draw;
+
+    /// Удаляет накопленные спрайты, сохраняя выделенную память.
+    void clear();
+    /*!
+     * Задаёт смещение, прибавляемое к положению последующих спрайтов.
+     * \param[in] offset Смещение в пикселях цели.
+     */
+    void setOffset(const sf::Vector2f &offset);
+    std::size_t quadsQuantity() const noexcept;
+
+    void drawQuad(
+        ResourceLoader::TextureId texture,
+        const sf::IntRect &rect,
+        const sf::Vector2f &position,
+        const sf::Color &color) override;
+    void draw(
+        sf::RenderTarget &target,
+        sf::RenderStates states) const override;
+
+private:
+    void buildAtlas();
+
+private:
+    sf::Texture m_atlas;
+    /// Положение каждой исходной текстуры в атласе.
+    std::map<ResourceLoader::TextureId, sf::Vector2f> m_atlasPositions;
+    sf::VertexArray m_vertices;
+    sf::Vector2f m_offset;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+
+#include <SFML/Graphics.hpp>
+
+#include <game/resource_loader.h>
+
+
+/*!
+ * Получатель спрайтов, выводящий их без участия sf::RenderTarget.
+ * Используется для отрисовки сцены в обход видеокарты, а также для сбора
+ * спрайтов многих сцен в один вызов отрисовки.
+ * Текстуры задаются идентификаторами ResourceLoader, поэтому спрайтам
+ * не нужны созданные текстуры: достаточно загруженных изображений.
+ */
+class SpriteSink
+{
+public:
+    virtual ~SpriteSink() = default;
+
+    /*!
+     * Выводит фрагмент текстуры в натуральную величину.
+     * \param[in] texture Текстура, содержащая фрагмент.
+     * \param[in] rect Фрагмент текстуры. Отрицательная ширина означает
+     * отражение по горизонтали, отрицательная высота - по вертикали.
+     * \param[in] position Положение левого верхнего угла фрагмента
+     * в пикселях цели.
+     * \param[in] color Цвет, на который умножается цвет текстуры.
+     */
+    virtual void drawQuad(
+        ResourceLoader::TextureId texture,
+        const sf::IntRect &rect,
+        const sf::Vector2f &position,
+        const sf::Color &color) = 0;
+
+    /*!
+     * Выводит спрайт с учётом преобразования координат.
+     * Поддерживаются только сдвиг и отражение, масштаб должен быть единичным.
+     * \param[in] sprite Выводимый спрайт.
+     * \param[in] texture Текстура спрайта.
+     * \param[in] transform Преобразование координат.
+     */
+    void draw(
+        const sf::Sprite &sprite,
+        ResourceLoader::TextureId texture,
+        const sf::Transform &transform = sf::Transform::Identity);
+};
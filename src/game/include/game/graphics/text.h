@@ -3,10 +3,19 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <game/graphics/sprite_sink.h>
+#include <game/resource_loader.h>
+
 
 // sf::Font: Abstraction and Bitmap Fonts
 // https://en.sfml-dev.org/forums/index.php?topic=21787.0
 
+/*!
+ * Текст, набранный растровым шрифтом.
+ * Символы хранятся готовым массивом вершин, который перестраивается только
+ * при изменении текста, начертания или выравнивания, и выводятся
+ * одним вызовом отрисовки.
+ */
 class Text final : public sf::Drawable
 {
 public:
@@ -22,6 +31,7 @@ public:
     void draw(
         sf::RenderTarget &target,
         sf::RenderStates states) const override;
+    void drawSprites(SpriteSink &sink) const;
 
     const sf::Vector2f &position() const;
     void setPosition(const sf::Vector2f &position);
@@ -47,5 +57,8 @@ private:
     Align m_align{ Align::Left };
     bool m_bold{ false };
     sf::Color m_color;
-    std::vector<sf::Sprite> m_characters;
+    TexturePtr m_texture;
+    /// Два треугольника на каждый отображаемый символ
+    /// в системе координат с началом в m_position.
+    sf::VertexArray m_vertices;
 };
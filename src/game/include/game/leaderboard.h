@@ -0,0 +1,198 @@
+#pragma once
+
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <game/config.h>
+#include <game/thread_pool.h>
+
+
+namespace
+{
+
+/// Количество лучших результатов, хранимых для каждого количества кранов.
+constexpr std::size_t LEADERBOARD_SIZE = 100;
+
+}
+
+
+/*!
+ * Таблицы рекордов игроков и отдельно ботов для каждого начального
+ * количества кранов. Результаты дописываются в двоичный журнал в фоновом
+ * потоке, а в памяти хранятся только LEADERBOARD_SIZE лучших результатов
+ * и лучший результат каждого игрока.
+ * Когда журнал становится много больше хранимых в памяти результатов,
+ * он заменяется журналом только из них.
+ * Формат файла (целые числа в порядке little-endian):
+ * - сигнатура "SKLB" (4 байта), версия формата (2 байта),
+ *   размер записи (2 байта);
+ * - записи: тип (1 байт), количество кранов (1 байт), длина имени игрока
+ *   (1 байт), таблица (1 байт: 0 - игроки, 1 - боты), счёт (4 байта),
+ *   время в секундах от начала эпохи Unix (8 байт), имя игрока в UTF-8,
+ *   дополненное нулями (16 байт).
+ */
+class Leaderboard final
+{
+public:
+    enum class Board : std::uint8_t
+    {
+        Players,
+        Bots
+    };
+
+    struct Entry
+    {
+        std::string player;
+        unsigned int score{ 0 };
+        /// Время в секундах от начала эпохи Unix.
+        std::int64_t time{ 0 };
+    };
+
+    /// Размер записи журнала.
+    static constexpr std::uint16_t RECORD_SIZE = 32;
+    /// Максимальная длина имени игрока в байтах. Длинные имена обрезаются.
+    static constexpr std::size_t MAX_PLAYER_LENGTH = 16;
+
+public:
+    /*!
+     * Singleton instance accessor.
+     * \return The reference to an instance of this class.
+     */
+    static Leaderboard& instance();
+
+    /*!
+     * Читает журнал и открывает его для дописывания.
+     * Если файла нет, он создаётся.
+     * \param[in] path Путь к файлу журнала.
+     * \return \c true, если журнал открыт.
+     */
+    bool open(const std::filesystem::path &path);
+    /*!
+     * Добавляет результат игры. Таблица обновляется сразу,
+     * журнал дописывается в фоновом потоке.
+     * \param[in] board Таблица.
+     * \param[in] cranesQuantity Начальное количество кранов.
+     * \param[in] player Имя игрока.
+     * \param[in] score Счёт.
+     */
+    void add(
+        Board board,
+        std::uint8_t cranesQuantity,
+        const std::string &player,
+        unsigned int score);
+    /*!
+     * Удаляет все результаты таблицы для указанного количества кранов.
+     * \param[in] board Таблица.
+     * \param[in] cranesQuantity Начальное количество кранов.
+     */
+    void clear(Board board, std::uint8_t cranesQuantity);
+    /*!
+     * \param[in] board Таблица.
+     * \param[in] cranesQuantity Начальное количество кранов.
+     * \param[in] quantity Количество результатов.
+     * \return Лучшие результаты в порядке убывания счёта.
+     */
+    std::vector<Entry> top(Board board, std::uint8_t cranesQuantity, std::size_t quantity) const;
+    /*!
+     * \param[in] board Таблица.
+     * \param[in] cranesQuantity Начальное количество кранов.
+     * \param[in] player Имя игрока.
+     * \return Лучший результат игрока, если он есть.
+     */
+    std::optional<Entry> best(
+        Board board,
+        std::uint8_t cranesQuantity,
+        const std::string &player) const;
+
+private:
+    // Singleton part.
+    Leaderboard() = default;
+    ~Leaderboard() = default;
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard(Leaderboard&&) = delete;
+    Leaderboard& operator=(Leaderboard&&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+private:
+    enum class RecordType : std::uint8_t
+    {
+        Score,
+        Clear
+    };
+
+    /// Порядок результатов в таблице: больший счёт, затем более ранний.
+    struct Rank
+    {
+        bool operator()(const Entry &left, const Entry &right) const noexcept
+        {
+            return left.score != right.score
+                ? left.score > right.score
+                : left.time < right.time;
+        }
+    };
+
+    struct Table
+    {
+        std::multiset<Entry, Rank> top;
+        std::unordered_map<std::string, Entry> bests;
+    };
+
+    static constexpr std::size_t BOARDS_QUANTITY = std::size_t(Board::Bots) + 1;
+
+    /// Таблицы по номеру таблицы и количеству кранов.
+    using Tables = std::array<std::array<Table, MAX_INITIAL_CRANES_QUANTITY>, BOARDS_QUANTITY>;
+
+private:
+    bool read();
+    /// Применяет запись журнала к таблицам.
+    static void apply(
+        Tables &tables,
+        RecordType type,
+        Board board,
+        std::uint8_t cranesQuantity,
+        const Entry &entry);
+    /// Дописывает запись в журнал. Вызывается фоновым потоком.
+    void append(
+        RecordType type,
+        Board board,
+        std::uint8_t cranesQuantity,
+        const Entry &entry);
+    /*!
+     * Заменяет журнал записями хранимых в памяти результатов.
+     * \param[in] tables Хранимые в памяти результаты.
+     */
+    bool compact(const Tables &tables);
+    /// \return Количество записей журнала после сжатия.
+    static std::size_t liveRecordsQuantity(const Tables &tables);
+    static Table* table(Tables &tables, Board board, std::uint8_t cranesQuantity);
+    static const Table* table(
+        const Tables &tables,
+        Board board,
+        std::uint8_t cranesQuantity);
+
+private:
+    /// Защищает таблицы.
+    mutable std::mutex m_mutex;
+    Tables m_tables;
+
+    /// Защищает журнал.
+    std::mutex m_fileMutex;
+    std::filesystem::path m_path;
+    std::ofstream m_file;
+    /// Результаты, записанные в журнал. Отстают от m_tables на записи,
+    /// ожидающие в очереди, и используются для сжатия журнала.
+    Tables m_journalTables;
+    /// Количество записей в журнале.
+    std::size_t m_recordsQuantity{ 0 };
+    /// Поток, дописывающий журнал. Выполняет записи по порядку.
+    ThreadPool m_writer{ 1 };
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+
+#include <boost/signals2.hpp>
+
+#include <SFML/Graphics.hpp>
+
+#include <game/screen.h>
+
+
+/*!
+ * Экран, отображаемый во время загрузки ресурсов.
+ * Показывает заставку, как только она загружена, пока остальные ресурсы
+ * продолжают загружаться в фоне.
+ */
+class LoadingScreen final : public Screen
+{
+public:
+    /// Параметр - признак успешной загрузки всех ресурсов.
+    using Signal = boost::signals2::signal<void(bool)>;
+    using Slot = Signal::slot_type;
+
+public:
+    explicit LoadingScreen();
+
+    void update(const Duration &elapsed) override;
+    bool handleKeyPressed(const sf::Keyboard::Key key) override;
+    void draw(
+        sf::RenderTarget &target,
+        sf::RenderStates states) const override;
+
+    boost::signals2::connection connectLoaded(const Slot &slot);
+
+private:
+    Signal m_signalLoaded;
+    sf::Sprite m_splash;
+    bool m_splashLoaded{ false };
+};
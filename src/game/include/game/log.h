@@ -2,12 +2,46 @@
 
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
 #include <filesystem>
+#include <fstream>
 #include <mutex>
 #include <optional>
 #include <sstream>
+#include <thread>
 
+#include <game/clock.h>
+#include <game/mpsc_queue.h>
 
+
+/*!
+ * Messages with lower severity are removed at compile time.
+ * The value is a number of Log::Severity.
+ */
+#ifndef LOG_MINIMUM_SEVERITY
+#define LOG_MINIMUM_SEVERITY 0
+#endif
+
+
+namespace
+{
+
+/// The maximum length of a message. Longer messages are truncated.
+constexpr std::size_t LOG_RECORD_SIZE = 256;
+/// The number of messages the queue holds before new messages are dropped.
+constexpr std::size_t LOG_QUEUE_CAPACITY = 1024;
+
+}
+
+
+/*!
+ * Asynchronous log.
+ * Producers only put preformatted messages into a lock-free queue.
+ * A background thread writes them in batches to the console
+ * and to a log file kept open between batches.
+ */
 class Log final
 {
 public:
@@ -23,6 +57,8 @@ public:
 
 public:
     static const std::array<std::string, Severity::Fatal + 1> SEVERITY_DESCRIPTIONS;
+    /// Messages with lower severity are removed at compile time.
+    static constexpr Severity COMPILED_MINIMUM_SEVERITY = Severity(LOG_MINIMUM_SEVERITY);
 
 public:
     /*!
@@ -33,9 +69,21 @@ public:
 
     void setPath(const std::optional<std::filesystem::path> &path);
     void setMinimumSeverity(Severity severity);
+    /*!
+     * Checks whether messages of the specified severity are written.
+     * Used to skip formatting of messages that would be discarded.
+     * \param severity The severity of message.
+     */
+    bool enabled(Severity severity) const noexcept
+    {
+        return severity >= m_minimumSeverity.load(std::memory_order_relaxed);
+    }
 
     /*!
      * Writes the specified message to log.
+     * The message is written by the background thread later, except
+     * for fatal messages, which are written before the function returns.
+     * If the queue is full, the message is dropped.
      * \param message The message to write.
      * \param severity The severity of message.
      * \param file The name of file where this function was called.
@@ -48,30 +96,68 @@ public:
         const std::string &file = std::string(),
         const int line = 0,
         const std::string &functionName = std::string());
+    /*!
+     * Blocks until all messages written so far are flushed
+     * to the console and to the log file.
+     */
+    void flush();
+    /// \return The number of messages dropped because the queue was full.
+    std::uint64_t droppedMessages() const noexcept;
 
 private:
     // Singleton part.
-    Log(){}
-    ~Log() = default;
+    Log();
+    ~Log();
     Log(const Log&) = delete;
     Log(Log&&) = delete;
     Log& operator=(Log&&) = delete;
     Log& operator=(const Log&) = delete;
 
 private:
-    void writeToFile(
-        const std::string &message,
-        const Severity severity,
-        const std::string &file,
-        const int line,
-        const std::string &functionName);
+    struct Record
+    {
+        SystemTimePoint time;
+        Severity severity{ Severity::Info };
+        std::uint16_t length{ 0 };
+        std::array<char, LOG_RECORD_SIZE> text;
+    };
+
+private:
+    /// The background thread function.
+    void run();
+    void writeRecord(const Record &record);
+    void reportDroppedMessages();
+    void flushStreams();
+    void openFile();
+    void checkLogSize();
 
 private:
+    MpscQueue<Record, LOG_QUEUE_CAPACITY> m_queue;
+    std::atomic<Severity> m_minimumSeverity{ Trace };
+    std::atomic<std::uint64_t> m_droppedMessages{ 0 };
+
+    std::thread m_thread;
+    /// Guards the members below up to the background thread ones.
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_flushed;
+    bool m_stopping{ false };
+    bool m_flushRequested{ false };
+    /// The number of messages flushed by the background thread.
+    std::size_t m_flushedQuantity{ 0 };
     /// The name of the file with log.
     std::optional<std::filesystem::path> m_filename;
-    Severity m_minimumSeverity{ Trace };
-    unsigned int m_lastLogSizeCheck{ 0 };
-    mutable std::mutex m_mutex;
+    bool m_filenameChanged{ false };
+
+    // Used by the background thread only.
+    std::optional<std::filesystem::path> m_openFilename;
+    std::ofstream m_file;
+    std::uintmax_t m_fileSize{ 0 };
+    std::uint64_t m_reportedDroppedMessages{ 0 };
+    /// The second the cached time string corresponds to.
+    std::time_t m_cachedSecond{ -1 };
+    std::string m_cachedTime;
+    std::string m_line;
 };
 
 
@@ -87,9 +173,15 @@ inline std::ostream& operator<<(std::ostream &stream, Log::Severity severity)
 
 #define LOG_SEV(msg, severity) \
 {\
-    std::stringstream ss;\
-    ss << msg;\
-    Log::instance().write(ss.str(), severity);\
+    if constexpr (severity >= Log::COMPILED_MINIMUM_SEVERITY)\
+    {\
+        if (Log::instance().enabled(severity))\
+        {\
+            std::stringstream ss;\
+            ss << msg;\
+            Log::instance().write(ss.str(), severity);\
+        }\
+    }\
 }
 #define LOG_TRACE(msg) LOG_SEV(msg, Log::Severity::Trace)
 #define LOG_DEBUG(msg) LOG_SEV(msg, Log::Severity::Debug)
@@ -0,0 +1,38 @@
+#pragma once
+
+
+#include <cstdint>
+#include <filesystem>
+
+
+/*!
+ * Файл, отображённый в память только для чтения.
+ * Содержимое доступно без копирования, пока объект существует.
+ */
+class MappedFile final
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /*!
+     * Отображает файл в память.
+     * \param[in] path Путь к файлу.
+     * \return \c true, если файл отображён.
+     */
+    bool open(const std::filesystem::path &path);
+    void close() noexcept;
+
+    const std::uint8_t* data() const noexcept;
+    std::size_t size() const noexcept;
+
+private:
+    const std::uint8_t *m_data{ nullptr };
+    std::size_t m_size{ 0 };
+#ifdef _WIN32
+    void *m_file{ nullptr };
+    void *m_mapping{ nullptr };
+#endif
+};
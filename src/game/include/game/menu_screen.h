@@ -10,11 +10,21 @@
 class MenuScreen final : public Screen
 {
 public:
-    using CloseSignal = boost::signals2::signal<void(bool)>;
+    enum class Result
+    {
+        Exit,
+        Start,
+        /// Продолжить сохранённую игру.
+        Resume
+    };
+    using CloseSignal = boost::signals2::signal<void(Result)>;
     using CloseSlot = CloseSignal::slot_type;
 
 public:
-    explicit MenuScreen();
+    /*!
+     * \param[in] resumable Есть сохранённая игра, которую можно продолжить.
+     */
+    explicit MenuScreen(bool resumable = false);
     virtual ~MenuScreen() = default;
 
     void update(const Duration &elapsed) override;
@@ -46,9 +56,11 @@ private:
     void closeMenuHighScore();
 
     void startGame();
+    void resumeGame();
     void exit();
 
 private:
+    bool m_resumable{ false };
     sf::Sprite m_background;
     CloseSignal m_signalClose;
     std::unique_ptr<Menu> m_menu;
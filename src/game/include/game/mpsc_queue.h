@@ -0,0 +1,107 @@
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+
+/*!
+ * Очередь фиксированной ёмкости без блокировок для нескольких поставщиков
+ * и одного потребителя. Каждая ячейка хранит номер очереди, по которому
+ * поставщики и потребитель узнают, свободна ли она.
+ * Не выделяет память после создания.
+ * \tparam T Тип элементов.
+ * \tparam Capacity Ёмкость очереди, степень двойки.
+ */
+template<typename T, std::size_t Capacity>
+class MpscQueue final
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0);
+
+public:
+    MpscQueue()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /*!
+     * Добавляет элемент в очередь. Может вызываться из любого потока.
+     * \return \c false, если очередь заполнена.
+     */
+    bool push(const T &value) noexcept
+    {
+        std::size_t position = m_head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell = m_cells[position % Capacity];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (m_head.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (sequence < position)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /*!
+     * Извлекает элемент из очереди. Вызывается только потребителем.
+     * \return \c false, если очередь пуста или следующий элемент
+     * ещё записывается.
+     */
+    bool pop(T &value) noexcept
+    {
+        Cell &cell = m_cells[m_tail % Capacity];
+        if (cell.sequence.load(std::memory_order_acquire) != m_tail + 1)
+        {
+            return false;
+        }
+        value = cell.value;
+        cell.sequence.store(m_tail + Capacity, std::memory_order_release);
+        ++m_tail;
+        return true;
+    }
+
+    /// Количество элементов, когда-либо добавленных в очередь.
+    std::size_t pushed() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire);
+    }
+
+    /// Количество элементов, когда-либо извлечённых из очереди.
+    /// Вызывается только потребителем.
+    std::size_t popped() const noexcept
+    {
+        return m_tail;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{ 0 };
+        T value{};
+    };
+
+private:
+    std::array<Cell, Capacity> m_cells;
+    alignas(64) std::atomic<std::size_t> m_head{ 0 };
+    alignas(64) std::size_t m_tail{ 0 };
+};
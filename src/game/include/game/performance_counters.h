@@ -0,0 +1,90 @@
+#pragma once
+
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+/*!
+ * Аппаратные счётчики производительности вызывающего потока.
+ * Доступны только в Linux (perf_event_open) и открываются явно.
+ * Если система не поддерживает счётчики или запрещает доступ к ним
+ * (см. /proc/sys/kernel/perf_event_paranoid), они остаются закрытыми,
+ * а read() возвращает нули.
+ */
+class PerformanceCounters final
+{
+public:
+    struct Values
+    {
+        /// Масштабированные значения могут немного уменьшаться,
+        /// поэтому разность ограничивается нулём.
+        Values operator-(const Values &other) const noexcept
+        {
+            return Values{
+                difference(cycles, other.cycles),
+                difference(instructions, other.instructions),
+                difference(cacheMisses, other.cacheMisses),
+                difference(branchMisses, other.branchMisses) };
+        }
+
+        std::uint64_t cycles{ 0 };
+        std::uint64_t instructions{ 0 };
+        /// Промахи кэша последнего уровня.
+        std::uint64_t cacheMisses{ 0 };
+        /// Неверно предсказанные переходы.
+        std::uint64_t branchMisses{ 0 };
+
+    private:
+        static std::uint64_t difference(std::uint64_t a, std::uint64_t b) noexcept
+        {
+            return a > b ? a - b : 0;
+        }
+    };
+
+public:
+    /// \return Счётчики вызывающего потока.
+    static PerformanceCounters& thread();
+
+    /*!
+     * Открывает и запускает счётчики вызывающего потока.
+     * Счётчики, которые не удалось открыть, кроме счётчика тактов,
+     * остаются нулевыми.
+     * \return \c false, если не удалось открыть счётчик тактов.
+     */
+    bool open();
+    void close() noexcept;
+    bool opened() const noexcept
+    {
+        return m_leader != -1;
+    }
+    /*!
+     * Если процессор разделял счётчики с другими группами, значения
+     * масштабируются на долю времени, в течение которой группа считала.
+     * \return Значения счётчиков с момента открытия.
+     */
+    Values read() const noexcept;
+
+private:
+    static constexpr std::size_t COUNTERS_QUANTITY = 4;
+
+private:
+    // Singleton part.
+    PerformanceCounters();
+    ~PerformanceCounters();
+    PerformanceCounters(const PerformanceCounters&) = delete;
+    PerformanceCounters(PerformanceCounters&&) = delete;
+    PerformanceCounters& operator=(PerformanceCounters&&) = delete;
+    PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+
+private:
+    /// Дескриптор счётчика тактов, ведущего группу счётчиков.
+    int m_leader{ -1 };
+    /// Дескрипторы счётчиков в порядке полей Values; -1, если не открыт.
+    std::array<int, COUNTERS_QUANTITY> m_descriptors;
+    /// Позиции значений счётчиков в прочитанной группе.
+    std::array<std::size_t, COUNTERS_QUANTITY> m_positions{};
+    /// Количество открытых счётчиков.
+    std::size_t m_quantity{ 0 };
+};
@@ -0,0 +1,218 @@
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include <game/allocation_tracker.h>
+#include <game/performance_counters.h>
+
+
+/*!
+ * Зоны профилирования компилируются только в отладочной сборке.
+ * В выпускной сборке макросы PROFILE_ZONE и PROFILE_FRAME пусты.
+ */
+#ifndef NDEBUG
+#define PROFILER_ENABLED
+#endif
+
+
+namespace
+{
+
+/// Количество последних кадров, по которым считается статистика.
+constexpr std::size_t PROFILER_HISTORY_SIZE = 120;
+
+}
+
+
+#ifdef PROFILER_ENABLED
+
+/*!
+ * Профилировщик горячих участков кода.
+ * Время, проведённое в зоне, выделения памяти и, если счётчики
+ * вызывающего потока открыты, аппаратные счётчики накапливаются за кадр.
+ * По окончании кадра суммы зон и значения кадра заносятся в историю
+ * последних PROFILER_HISTORY_SIZE кадров.
+ */
+class Profiler final
+{
+public:
+    enum class Zone : std::uint8_t
+    {
+        GameUpdate,
+        WindowEvents,
+        UpdatePlayer,
+        UpdateBoxes,
+        UpdateCrane,
+        WorldDraw,
+        WindowEndDraw
+    };
+
+    static constexpr std::size_t ZONES_QUANTITY = std::size_t(Zone::WindowEndDraw) + 1;
+    static const std::array<std::string, ZONES_QUANTITY> ZONE_NAMES;
+
+    struct Statistics
+    {
+        std::chrono::nanoseconds average{ 0 };
+        /// 99-й процентиль.
+        std::chrono::nanoseconds p99{ 0 };
+        /// Среднее количество выделений памяти за кадр.
+        double allocations{ 0 };
+        /// Среднее количество выделенных за кадр байтов.
+        double bytes{ 0 };
+        // Средние значения аппаратных счётчиков за кадр.
+        double cycles{ 0 };
+        double instructions{ 0 };
+        double cacheMisses{ 0 };
+        double branchMisses{ 0 };
+    };
+
+    /// Значения последних кадров, от старых к новым.
+    using History = std::array<std::int64_t, PROFILER_HISTORY_SIZE>;
+
+    /// Измеряет время, выделения памяти и аппаратные счётчики
+    /// вызывающего потока от создания до уничтожения объекта.
+    class Scope final
+    {
+    public:
+        explicit Scope(Zone zone) noexcept
+            : m_zone(zone)
+            , m_allocations(AllocationTracker::thread())
+            , m_counters(PerformanceCounters::thread().read())
+            , m_start(std::chrono::steady_clock::now())
+        {
+        }
+        ~Scope()
+        {
+            const std::chrono::nanoseconds duration =
+                std::chrono::steady_clock::now() - m_start;
+            Profiler::instance().add(
+                m_zone,
+                duration,
+                AllocationTracker::thread() - m_allocations,
+                PerformanceCounters::thread().read() - m_counters);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const Zone m_zone;
+        const AllocationTracker::Counters m_allocations;
+        const PerformanceCounters::Values m_counters;
+        const std::chrono::steady_clock::time_point m_start;
+    };
+
+public:
+    /*!
+     * Singleton instance accessor.
+     * \return The reference to an instance of this class.
+     */
+    static Profiler& instance();
+
+    /*!
+     * Добавляет измерения к зоне текущего кадра.
+     * Может вызываться из любого потока.
+     * \param[in] zone Зона.
+     * \param[in] duration Время, проведённое в зоне.
+     * \param[in] allocations Выделения памяти в зоне.
+     * \param[in] counters Значения аппаратных счётчиков в зоне.
+     */
+    void add(
+        Zone zone,
+        std::chrono::nanoseconds duration,
+        const AllocationTracker::Counters &allocations,
+        const PerformanceCounters::Values &counters) noexcept
+    {
+        add(zone, Metric::Time, duration.count());
+        add(zone, Metric::Allocations, allocations.allocations);
+        add(zone, Metric::Bytes, allocations.bytes);
+        add(zone, Metric::Cycles, counters.cycles);
+        add(zone, Metric::Instructions, counters.instructions);
+        add(zone, Metric::CacheMisses, counters.cacheMisses);
+        add(zone, Metric::BranchMisses, counters.branchMisses);
+    }
+    /// Завершает кадр. Вызывается игровым потоком.
+    void endFrame();
+
+    Statistics statistics(Zone zone) const;
+    Statistics frameStatistics() const;
+    /// \return Длительности последних кадров в наносекундах, от старых к новым.
+    History frameHistory() const;
+    /// \return Количество кадров в истории.
+    std::size_t historySize() const noexcept;
+
+private:
+    /// Величины, измеряемые в зонах и кадрах.
+    enum class Metric : std::uint8_t
+    {
+        /// Наносекунды.
+        Time,
+        Allocations,
+        Bytes,
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses
+    };
+
+    static constexpr std::size_t METRICS_QUANTITY = std::size_t(Metric::BranchMisses) + 1;
+
+    using Histories = std::array<History, METRICS_QUANTITY>;
+
+private:
+    // Singleton part.
+    Profiler() = default;
+    ~Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+    Profiler& operator=(Profiler&&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+private:
+    template<typename T>
+    void add(Zone zone, Metric metric, T value) noexcept
+    {
+        m_current[std::size_t(zone)][std::size_t(metric)].fetch_add(
+            std::int64_t(value),
+            std::memory_order_relaxed);
+    }
+    Statistics statistics(const Histories &histories) const;
+    double average(const History &history) const;
+
+private:
+    /// Значения зон в текущем кадре.
+    std::array<std::array<std::atomic<std::int64_t>, METRICS_QUANTITY>, ZONES_QUANTITY>
+        m_current{};
+
+    // Используется только игровым потоком.
+    std::array<Histories, ZONES_QUANTITY> m_zoneHistories{};
+    Histories m_frameHistories{};
+    /// Выделения памяти всех потоков к началу текущего кадра.
+    AllocationTracker::Counters m_frameStartAllocations;
+    /// Аппаратные счётчики игрового потока к началу текущего кадра.
+    PerformanceCounters::Values m_frameStartCounters;
+    /// Индекс, по которому будет записан следующий кадр.
+    std::size_t m_position{ 0 };
+    std::size_t m_size{ 0 };
+    std::optional<std::chrono::steady_clock::time_point> m_frameStart;
+};
+
+
+#define PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_IMPL(a, b)
+/// Измеряет время до конца области видимости. zone - элемент Profiler::Zone.
+#define PROFILE_ZONE(zone) \
+    const Profiler::Scope PROFILE_CONCATENATE(profileScope, __LINE__)(Profiler::Zone::zone)
+#define PROFILE_FRAME() Profiler::instance().endFrame()
+
+#else
+
+#define PROFILE_ZONE(zone)
+#define PROFILE_FRAME()
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,70 @@
+#pragma once
+
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <SFML/Window.hpp>
+
+#include <game/clock.h>
+
+
+class BinaryReader;
+class BinaryWriter;
+
+
+/*!
+ * Запись игры: начальные условия мира и всё, что на него влияло.
+ * Повторение нажатий клавиш с теми же интервалами обновления
+ * воспроизводит игру кадр в кадр.
+ */
+struct Replay
+{
+    /// Нажатие или отпускание клавиши перед обновлением мира.
+    struct Input
+    {
+        /// Номер обновления мира, перед которым обрабатывается событие.
+        std::uint32_t tick;
+        sf::Keyboard::Key key;
+        bool pressed;
+    };
+
+    /// Серия обновлений мира с одинаковым интервалом.
+    struct Interval
+    {
+        std::uint32_t ticks;
+        Duration elapsed;
+    };
+
+    /*!
+     * Добавляет обновление мира.
+     * \param[in] elapsed Время, прошедшее с прошлого обновления.
+     */
+    void addTick(const Duration &elapsed);
+    /// Общее количество обновлений мира.
+    std::uint32_t ticks() const noexcept;
+
+    std::uint32_t seed{ 0 };
+    std::optional<unsigned int> positionIndex;
+    std::uint8_t cranesQuantity{ 1 };
+    /// Клавиши отладки действовали во время игры.
+    bool debugMode{ false };
+    std::vector<Input> inputs;
+    std::vector<Interval> intervals;
+};
+
+
+bool writeReplay(const std::filesystem::path &path, const Replay &replay);
+bool readReplay(const std::filesystem::path &path, Replay &replay);
+/*!
+ * Записывает запись игры без заголовка файла.
+ * Используется для встраивания записи в другие файлы.
+ */
+void writeReplay(BinaryWriter &writer, const Replay &replay);
+/*!
+ * Читает запись игры, записанную writeReplay(BinaryWriter&, const Replay&).
+ * \return \c false, если данных недостаточно.
+ */
+bool readReplay(BinaryReader &reader, Replay &replay);
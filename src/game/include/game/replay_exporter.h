@@ -0,0 +1,39 @@
+#pragma once
+
+
+#include <cstdint>
+#include <filesystem>
+
+#include <game/replay.h>
+
+
+/*!
+ * Покадровый экспорт записанной игры без окна и видеокарты.
+ * Мир обновляется с записанными интервалами так быстро, как позволяет
+ * процессор, кадры рисуются SoftwareRenderer и сохраняются
+ * последовательностью PNG файлов пулом потоков кодирования.
+ * Изображения ресурсов должны быть загружены до экспорта
+ * (достаточно ResourceLoader::loadImages()).
+ */
+class ReplayExporter final
+{
+public:
+    /*!
+     * \param[in] directory Каталог, в который сохраняются кадры.
+     * Создаётся, если не существует.
+     */
+    explicit ReplayExporter(const std::filesystem::path &directory);
+
+    /*!
+     * Экспортирует запись игры.
+     * \param[in] replay Запись игры.
+     * \return \c true, если все кадры сохранены, \c false - в противном случае.
+     */
+    bool exportReplay(const Replay &replay);
+
+private:
+    std::filesystem::path framePath(std::uint32_t index) const;
+
+private:
+    std::filesystem::path m_directory;
+};
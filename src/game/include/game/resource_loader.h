@@ -2,6 +2,8 @@
 
 
 #include <cstdint>
+#include <filesystem>
+#include <future>
 #include <map>
 #include <memory>
 
@@ -10,9 +12,27 @@
 
 
 using TexturePtr = std::shared_ptr<const sf::Texture>;
+using ImagePtr = std::shared_ptr<const sf::Image>;
 using SoundBufferPtr = std::shared_ptr<const sf::SoundBuffer>;
 
 
+class ResourcePack;
+class ThreadPool;
+
+
+/// Декодированный звук, ещё не переданный звуковой подсистеме.
+struct SoundSamples
+{
+    const sf::Int16 *samples{ nullptr };
+    std::size_t samplesQuantity{ 0 };
+    unsigned int channelCount{ 0 };
+    unsigned int sampleRate{ 0 };
+    /// Владелец памяти, в которой находятся отсчёты.
+    std::shared_ptr<const void> storage;
+};
+using SoundSamplesPtr = std::shared_ptr<const SoundSamples>;
+
+
 class ResourceLoader final
 {
 public:
@@ -55,24 +75,110 @@ public:
      */
     static ResourceLoader& instance();
 
+    /*!
+     * Задаёт архив, из которого загружаются ресурсы.
+     * Если архив не задан, ресурсы загружаются из файлов каталога
+     * "resources" в текущем каталоге.
+     * Должен вызываться до начала загрузки.
+     * \param[in] pack Архив ресурсов.
+     */
+    void setResourcePack(const std::shared_ptr<const ResourcePack> &pack);
+    /*!
+     * Ищет файл архива ресурсов resources.pak в текущем каталоге и рядом
+     * с исполняемым файлом и задаёт первый найденный архив.
+     * Если архива нет, ресурсы загружаются из каталога "resources".
+     * \param[in] executablePath Путь к исполняемому файлу.
+     * \return \c false, если архив есть, но открыть его не удалось.
+     */
+    bool openResourcePack(const std::filesystem::path &executablePath);
+    /*!
+     * Загружает все ресурсы, дожидаясь окончания загрузки.
+     * \return \c true, если все ресурсы загружены.
+     */
     bool load();
+    /*!
+     * Загружает только изображения, без текстур и звуковых буферов,
+     * дожидаясь окончания декодирования. Не требует контекста OpenGL.
+     * Изображений достаточно для игровых миров без окна
+     * и SoftwareRenderer.
+     * \return \c true, если все изображения загружены.
+     */
+    bool loadImages();
+    /*!
+     * Задаёт архив ресурсов (см. openResourcePack()) и загружает
+     * изображения (см. loadImages()). Используется инструментами,
+     * которые создают игровые миры без окна.
+     * \param[in] executablePath Путь к исполняемому файлу.
+     * \return \c true, если все изображения загружены.
+     */
+    bool loadImages(const std::filesystem::path &executablePath);
+    /*!
+     * Запускает декодирование всех ресурсов в пуле потоков.
+     * Заставка декодируется первой. Текстуры и звуковые буферы создаются
+     * из декодированных данных в update().
+     */
+    void startLoading();
+    /*!
+     * Создаёт текстуры и звуковые буферы из ресурсов, декодирование
+     * которых завершилось. Вызывается в потоке отрисовки.
+     * \return \c false, если загрузить какой-либо ресурс не удалось.
+     */
+    bool update();
+    /// \return \c true, если все ресурсы загружены.
+    bool loaded() const noexcept;
+    /*!
+     * Возвращает результат декодирования изображения.
+     * Действителен после вызова startLoading().
+     * \return Пустой указатель в результате, если декодировать не удалось.
+     */
+    std::shared_future<ImagePtr> decodedImage(TextureId id) const;
+    /*!
+     * Возвращает результат декодирования звука.
+     * Действителен после вызова startLoading().
+     * \return Пустой указатель в результате, если декодировать не удалось.
+     */
+    std::shared_future<SoundSamplesPtr> decodedSound(SoundId id) const;
+
+    /// \return Пустой указатель, если текстура ещё не загружена.
     TexturePtr texture(const TextureId &id) const noexcept;
+    /*!
+     * Возвращает декодированное изображение, из которого создана текстура.
+     * Изображение хранится в оперативной памяти и доступно
+     * без обращения к видеокарте.
+     */
+    ImagePtr image(const TextureId &id) const noexcept;
+    /// \return Размер изображения текстуры либо нули, если оно не загружено.
+    sf::Vector2u textureSize(const TextureId &id) const noexcept;
+    /*!
+     * Назначает спрайту текстуру, если она создана, и фрагмент
+     * во всё изображение. Спрайт без текстуры выводится только
+     * в SpriteSink.
+     * \param[out] sprite Спрайт.
+     * \param[in] id Текстура.
+     */
+    void applyTexture(sf::Sprite &sprite, const TextureId &id) const;
     SoundBufferPtr sound(const SoundId &id) const noexcept;
 
 private:
     // Singleton part.
-    ResourceLoader() = default;
-    ~ResourceLoader() = default;
+    ResourceLoader();
+    ~ResourceLoader();
     ResourceLoader(const ResourceLoader&) = delete;
     ResourceLoader(ResourceLoader&&) = delete;
     ResourceLoader& operator=(ResourceLoader&&) = delete;
     ResourceLoader& operator=(const ResourceLoader&) = delete;
 
 private:
-    bool loadTexture(const TextureId id, const std::string &file);
-    bool loadSound(const SoundId id, const std::string &file);
+    bool uploadTexture(TextureId id, const ImagePtr &image);
+    bool uploadSound(SoundId id, const SoundSamplesPtr &samples);
 
 private:
+    std::shared_ptr<const ResourcePack> m_resourcePack;
+    std::unique_ptr<ThreadPool> m_threadPool;
+    std::map<TextureId, std::shared_future<ImagePtr>> m_decodedImages;
+    std::map<SoundId, std::shared_future<SoundSamplesPtr>> m_decodedSounds;
+
     std::map<TextureId, std::shared_ptr<sf::Texture>> m_textures;
+    std::map<TextureId, ImagePtr> m_images;
     std::map<SoundId, std::shared_ptr<sf::SoundBuffer>> m_sounds;
 };
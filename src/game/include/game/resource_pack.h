@@ -0,0 +1,83 @@
+#pragma once
+
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+
+#include <game/mapped_file.h>
+
+
+namespace
+{
+
+/// Выравнивание данных записей в архиве ресурсов.
+constexpr std::size_t RESOURCE_PACK_ALIGNMENT = 16;
+
+}
+
+
+/*!
+ * Архив ресурсов игры, читаемый без копирования.
+ * Формат (целые числа в порядке little-endian):
+ * - сигнатура "SKPK" (4 байта), версия формата (4 байта),
+ *   количество записей (4 байта);
+ * - для каждой записи: смещение данных от начала архива (8 байт),
+ *   размер данных (8 байт), длина имени (2 байта), имя;
+ * - данные записей, каждая начинается со смещения,
+ *   кратного RESOURCE_PACK_ALIGNMENT.
+ * Имя записи - путь файла относительно каталога ресурсов
+ * с разделителем '/', например "graphics/box.png".
+ */
+class ResourcePack final
+{
+public:
+    /// Содержимое записи архива.
+    struct Blob
+    {
+        const std::uint8_t *data{ nullptr };
+        std::size_t size{ 0 };
+    };
+
+public:
+    /*!
+     * Отображает архив из файла в память.
+     * \param[in] path Путь к архиву.
+     * \return \c true, если архив открыт и его оглавление корректно.
+     */
+    bool open(const std::filesystem::path &path);
+    /*!
+     * Открывает архив, уже находящийся в памяти, например встроенный
+     * в исполняемый файл. Память должна оставаться действительной,
+     * пока используется архив.
+     * \param[in] data Начало архива.
+     * \param[in] size Размер архива.
+     * \return \c true, если оглавление архива корректно.
+     */
+    bool open(const std::uint8_t *data, std::size_t size);
+    /*!
+     * Возвращает содержимое записи.
+     * \param[in] name Имя записи.
+     * \return Пустой указатель, если записи нет в архиве.
+     */
+    const Blob* find(const std::string &name) const noexcept;
+
+private:
+    bool readIndex(const std::uint8_t *data, std::size_t size);
+
+private:
+    MappedFile m_file;
+    std::map<std::string, Blob> m_entries;
+};
+
+
+/*!
+ * Собирает архив из изображений и звуков каталога ресурсов.
+ * \param[in] directory Каталог ресурсов.
+ * \param[in] path Путь к создаваемому архиву.
+ * \return \c true, если архив записан.
+ */
+bool writeResourcePack(
+    const std::filesystem::path &directory,
+    const std::filesystem::path &path);
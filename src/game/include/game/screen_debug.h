@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <game/profiler.h>
 #include <game/screen.h>
 #include <game/world.h>
 
@@ -19,6 +20,12 @@ public:
 
 private:
     void setup();
+#ifdef PROFILER_ENABLED
+    /// Выводит среднее время и 99-й процентиль кадра и зон профилирования.
+    void writeProfile(std::ostream &stream) const;
+    /// Строит график длительности последних кадров под текстом.
+    void updateGraph();
+#endif
 
 private:
     // NOTE: Без указателей объекты sf::Font и sf::Text портятся
@@ -26,4 +33,10 @@ private:
     std::unique_ptr<sf::Font> m_font;
     std::unique_ptr<sf::Text> m_text;
     std::shared_ptr<const World> m_world;
+#ifdef PROFILER_ENABLED
+    /// График длительности кадров.
+    sf::VertexArray m_graph;
+    /// Линия длительности кадра при FPS_LIMIT.
+    sf::VertexArray m_graphBudget;
+#endif
 };
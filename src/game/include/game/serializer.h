@@ -1,5 +1,22 @@
 #pragma once
 
 
-bool writeConfig();
-bool readConfig();
+#include <optional>
+
+#include <game/config.h>
+
+
+/*!
+ * Записывает настройки во временный файл и заменяет им файл настроек,
+ * так что при сбое остаётся либо старый, либо новый файл целиком.
+ * \param[in] values Записываемые настройки.
+ * \return \c true, если настройки записаны.
+ */
+bool writeConfig(const Config::Values &values);
+/*!
+ * Читает настройки из файла настроек.
+ * \param[out] legacyHighScore Рекорд, который прежние версии хранили
+ * в настройках, если он есть в файле.
+ * \return \c true, если настройки прочитаны.
+ */
+bool readConfig(std::optional<unsigned int> &legacyHighScore);
@@ -0,0 +1,38 @@
+#pragma once
+
+
+#include <game/resource_loader.h>
+
+
+/// Получатель звуков, запускаемых игровым миром.
+class SoundSink
+{
+public:
+    virtual ~SoundSink() = default;
+
+    /*!
+     * Запускает звук. Не должен блокировать вызывающий поток.
+     * \param[in] id Идентификатор звука.
+     */
+    virtual void playSound(ResourceLoader::SoundId id) = 0;
+};
+
+
+/// Получатель звуков, ничего не воспроизводящий. Для работы без звука.
+class NullSoundSink final : public SoundSink
+{
+public:
+    /*!
+     * Singleton instance accessor.
+     * \return The reference to an instance of this class.
+     */
+    static NullSoundSink& instance()
+    {
+        static NullSoundSink singleton;
+        return singleton;
+    }
+
+    void playSound(ResourceLoader::SoundId) override
+    {
+    }
+};
@@ -1,13 +1,67 @@
 #pragma once
 
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
 #include <SFML/Audio.hpp>
 
-#include "resource_loader.h"
+#include <game/clock.h>
+#include <game/resource_loader.h>
+#include <game/sound_sink.h>
+#include <game/spsc_queue.h>
 
 
-class SoundSystem final
+namespace
 {
+
+/// Количество различных звуков.
+constexpr std::size_t SOUNDS_QUANTITY =
+    std::size_t(ResourceLoader::SoundId::GameOver) + 1;
+/// Количество голосов, закреплённых за каждым звуком.
+constexpr std::size_t VOICES_PER_SOUND = 3;
+/// Максимальное количество одновременно звучащих голосов.
+constexpr std::size_t MAX_PLAYING_VOICES = 8;
+/// Ёмкость очереди звуковых событий.
+constexpr std::size_t SOUND_EVENTS_CAPACITY = 64;
+
+}
+
+
+/*!
+ * Полифоническое воспроизведение звуков.
+ * Все голоса создаются заранее и закрепляются за звуками, как только
+ * звуки загружены, поэтому запуск звука не выделяет память.
+ * Если все голоса звука заняты, перезапускается самый давно запущенный
+ * из них. Если одновременно звучит MAX_PLAYING_VOICES голосов,
+ * останавливается голос с наименьшим приоритетом, а среди равных -
+ * самый давно запущенный. Звук с меньшим приоритетом, чем у всех
+ * звучащих голосов, не воспроизводится.
+ * Повторные запуски одного и того же звука в течение одного кадра
+ * объединяются.
+ * playSound() помещает событие в очередь без блокировок и будит поток
+ * воспроизведения. Обращения к звуковой подсистеме выполняются в этом
+ * потоке, который запускается, как только звуки загружены, и спит,
+ * пока очередь пуста.
+ */
+class SoundSystem final : public SoundSink
+{
+public:
+    /// Статистика обработки звуковых событий.
+    struct Statistics
+    {
+        /// Средняя задержка между запуском звука и его воспроизведением.
+        Duration averageLatency{};
+        /// Максимальная задержка между запуском звука и его воспроизведением.
+        Duration maximumLatency{};
+        /// Количество событий, потерянных из-за переполнения очереди.
+        std::uint64_t droppedEvents{ 0 };
+    };
+
 public:
     /*!
      * Singleton instance accessor.
@@ -16,22 +70,82 @@ public:
     static SoundSystem& instance();
     void setEnabled(bool value);
 
-    void playSound(ResourceLoader::SoundId id);
+    /*!
+     * Начинает новый кадр. Вызывается один раз за кадр
+     * перед обновлением экрана.
+     */
+    void update();
+    void playSound(ResourceLoader::SoundId id) override;
+    Statistics statistics() const noexcept;
 
 private:
     // Singleton part.
     SoundSystem();
-    ~SoundSystem() = default;
+    ~SoundSystem() override;
     SoundSystem(const SoundSystem&) = delete;
     SoundSystem(SoundSystem&&) = delete;
     SoundSystem& operator=(SoundSystem&&) = delete;
     SoundSystem& operator=(const SoundSystem&) = delete;
 
+private:
+    struct Voice
+    {
+        sf::Sound sound;
+        /// Порядковый номер запуска голоса. Больше у недавно запущенных.
+        std::uint64_t startIndex{ 0 };
+    };
+    using Voices = std::array<Voice, VOICES_PER_SOUND>;
+
+    /// Событие запуска звука, передаваемое в поток воспроизведения.
+    struct Event
+    {
+        ResourceLoader::SoundId id{ ResourceLoader::SoundId::Jump };
+        /// Номер кадра, в котором запущен звук.
+        std::uint64_t frame{ 0 };
+        /// Время запуска звука.
+        TimePoint time{};
+    };
+
 private:
     void setup();
+    /// Функция потока воспроизведения.
+    void run();
+    /// Воспроизводит звук события. Вызывается в потоке воспроизведения.
+    void trigger(const Event &event);
+    /// Закрепляет голоса за звуковыми буферами.
+    void bindVoices();
+    /*!
+     * Освобождает голос для нового звука, если звучит
+     * максимальное количество голосов.
+     * \param[in] priority Приоритет нового звука.
+     * \return \c false, если все звучащие голоса важнее нового звука.
+     */
+    bool reserveVoice(std::uint8_t priority);
 
 private:
-    sf::Sound m_sound;
+    // Используются потоком, вызывающим playSound().
+    std::uint64_t m_frame{ 1 };
     bool m_enabled{ false };
     ResourceLoader &m_resourceLoader;
+
+    SpscQueue<Event, SOUND_EVENTS_CAPACITY> m_events;
+    std::thread m_thread;
+    /// Защищает пробуждение потока воспроизведения.
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    /// Количество событий, помещённых в очередь.
+    std::uint64_t m_pushedQuantity{ 0 };
+    bool m_stopping{ false };
+
+    // Используются только потоком воспроизведения.
+    std::array<Voices, SOUNDS_QUANTITY> m_voices;
+    /// Номер кадра, в котором звук был запущен последний раз.
+    std::array<std::uint64_t, SOUNDS_QUANTITY> m_triggerFrames{};
+    std::uint64_t m_startIndex{ 0 };
+
+    // Статистика.
+    std::atomic<std::uint64_t> m_latencySum{ 0 };
+    std::atomic<std::uint64_t> m_latencyMaximum{ 0 };
+    std::atomic<std::uint64_t> m_eventsQuantity{ 0 };
+    std::atomic<std::uint64_t> m_droppedEvents{ 0 };
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+
+#include <memory>
+#include <vector>
+
+#include <boost/signals2.hpp>
+
+#include <SFML/Graphics.hpp>
+
+#include <game/bot.h>
+#include <game/screen.h>
+#include <game/world.h>
+#include <game/graphics/sprite_batch.h>
+
+
+/*!
+ * Экран наблюдения за множеством одновременных игр ботов.
+ * Игровые миры располагаются сеткой, каждый в своей ячейке размера
+ * SCREEN_SIZE. Спрайты всех миров собираются в один SpriteBatch,
+ * поэтому вся сетка выводится одним вызовом отрисовки.
+ */
+class SpectatorScreen final : public Screen
+{
+public:
+    using Signal = boost::signals2::signal<void()>;
+    using Slot = Signal::slot_type;
+
+public:
+    /*!
+     * Возвращает размер сетки миров в пикселях игрового мира.
+     * \param[in] worldsQuantity Количество миров.
+     */
+    static sf::Vector2u frameSize(std::size_t worldsQuantity) noexcept;
+
+public:
+    /*!
+     * \param[in] worldsQuantity Количество одновременных игр.
+     */
+    explicit SpectatorScreen(std::size_t worldsQuantity);
+
+    void update(const Duration &elapsed) override;
+    bool handleKeyPressed(const sf::Keyboard::Key key) override;
+    void draw(
+        sf::RenderTarget &target,
+        sf::RenderStates states) const override;
+
+    boost::signals2::connection connectClose(const Slot &slot);
+
+private:
+    struct Tile
+    {
+        std::unique_ptr<World> world;
+        RandomBot bot;
+        /// Время, прошедшее после окончания игры.
+        std::optional<Duration> gameOverElapsed;
+    };
+
+private:
+    void setup(std::size_t worldsQuantity);
+
+private:
+    Signal m_signalClose;
+    std::vector<Tile> m_tiles;
+    /// Количество столбцов сетки.
+    std::size_t m_columns{ 1 };
+    mutable SpriteBatch m_batch;
+};
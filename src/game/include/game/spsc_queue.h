@@ -0,0 +1,58 @@
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+
+/*!
+ * Очередь фиксированной ёмкости без блокировок для одного поставщика
+ * и одного потребителя. Не выделяет память после создания.
+ * \tparam T Тип элементов. Должен быть дёшево копируемым.
+ * \tparam Capacity Ёмкость очереди, степень двойки.
+ */
+template<typename T, std::size_t Capacity>
+class SpscQueue final
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0);
+
+public:
+    /*!
+     * Добавляет элемент в очередь. Вызывается только поставщиком.
+     * \return \c false, если очередь заполнена.
+     */
+    bool push(const T &value) noexcept
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        m_items[head % Capacity] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*!
+     * Извлекает элемент из очереди. Вызывается только потребителем.
+     * \return \c false, если очередь пуста.
+     */
+    bool pop(T &value) noexcept
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = m_items[tail % Capacity];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> m_items{};
+    // Счётчики в разных строках кэша, чтобы потоки не мешали друг другу.
+    alignas(64) std::atomic<std::size_t> m_head{ 0 };
+    alignas(64) std::atomic<std::size_t> m_tail{ 0 };
+};
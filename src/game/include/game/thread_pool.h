@@ -0,0 +1,64 @@
+#pragma once
+
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+/*!
+ * Пул потоков, выполняющих задачи в порядке поступления.
+ * При уничтожении пул дожидается выполнения всех поставленных задач.
+ */
+class ThreadPool final
+{
+public:
+    /*!
+     * \param[in] threadsQuantity Количество потоков. Если равно 0,
+     * используется количество аппаратных потоков.
+     */
+    explicit ThreadPool(std::size_t threadsQuantity = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /*!
+     * Ставит задачу в очередь.
+     * \param[in] function Задача.
+     * \return Результат задачи.
+     */
+    template<typename F>
+    std::future<std::invoke_result_t<F>> submit(F &&function)
+    {
+        using Result = std::invoke_result_t<F>;
+        // std::function требует копируемости, поэтому задача
+        // хранится в разделяемом указателе.
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<F>(function));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace_back([task]() { (*task)(); });
+        }
+        m_condition.notify_one();
+        return result;
+    }
+
+    std::size_t threadsQuantity() const noexcept;
+
+private:
+    void run();
+
+private:
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stopping{ false };
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <game/clock.h>
+
+
+namespace
+{
+
+/// Количество событий в блоке буфера потока. Буфер растёт блоками,
+/// поэтому запись события не копирует ранее записанные.
+constexpr std::size_t TRACE_BLOCK_EVENTS = 4096;
+
+}
+
+
+/*!
+ * Трассировка выполнения для просмотра на временной шкале
+ * (chrome://tracing, Perfetto).
+ * События начала и конца участков кода накапливаются в памяти в буфере
+ * потока, в котором возникли. Трасса записывается в формате Chrome trace
+ * event (JSON) при закрытии и по запросу, например по клавише.
+ * Событие занимает 24 байта, поэтому 10 минут игры занимают
+ * порядка десятков мегабайт.
+ */
+class Tracer final
+{
+public:
+    struct Event
+    {
+        /// Строковый литерал.
+        const char *name{ nullptr };
+        /// Время от открытия трассы, наносекунды.
+        std::int64_t time{ 0 };
+        /// 'B' - начало участка, 'E' - конец.
+        char phase{ 'B' };
+    };
+
+    /// Отмечает начало и конец участка кода временем жизни объекта.
+    class Scope final
+    {
+    public:
+        explicit Scope(const char *name)
+            : m_name(Tracer::instance().enabled() ? name : nullptr)
+        {
+            if (m_name != nullptr)
+            {
+                Tracer::instance().append(m_name, 'B');
+            }
+        }
+        ~Scope()
+        {
+            if (m_name != nullptr)
+            {
+                Tracer::instance().append(m_name, 'E');
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char *const m_name;
+    };
+
+public:
+    /*!
+     * Singleton instance accessor.
+     * \return The reference to an instance of this class.
+     */
+    static Tracer& instance();
+
+    /*!
+     * Включает трассировку. Вызывается до запуска трассируемых потоков.
+     * \param[in] path Путь к файлу трассы.
+     * \return \c true, если файл удалось создать.
+     */
+    bool open(const std::filesystem::path &path);
+    /// Записывает трассу и выключает трассировку.
+    void close();
+    /*!
+     * Записывает события, накопленные с открытия трассы.
+     * Трассировка продолжается.
+     * \return \c true, если трасса записана.
+     */
+    bool write();
+    bool enabled() const noexcept
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+    /*!
+     * Задаёт имя вызывающего потока, отображаемое на временной шкале.
+     * \param[in] name Строковый литерал.
+     */
+    void setThreadName(const char *name);
+
+private:
+    class ThreadBuffer;
+
+private:
+    // Singleton part.
+    Tracer() = default;
+    ~Tracer() = default;
+    Tracer(const Tracer&) = delete;
+    Tracer(Tracer&&) = delete;
+    Tracer& operator=(Tracer&&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+private:
+    /// \return Буфер событий вызывающего потока.
+    ThreadBuffer& threadBuffer();
+    void append(const char *name, char phase);
+
+private:
+    std::atomic<bool> m_enabled{ false };
+    TimePoint m_start;
+
+    /// Защищает члены ниже.
+    std::mutex m_mutex;
+    std::filesystem::path m_path;
+    /// Буферы удерживаются после завершения их потоков до записи трассы.
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+};
+
+
+#define TRACE_CONCATENATE_IMPL(a, b) a##b
+#define TRACE_CONCATENATE(a, b) TRACE_CONCATENATE_IMPL(a, b)
+/// Отмечает участок кода до конца области видимости. name - строковый литерал.
+#define TRACE_SCOPE(name) \
+    const Tracer::Scope TRACE_CONCATENATE(traceScope, __LINE__)(name)
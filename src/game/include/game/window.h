@@ -38,33 +38,66 @@ public:
     bool isDone() const noexcept;
     void close();
     bool isFullscreen();
-    sf::RenderWindow& gameWindow() noexcept;
+    /*!
+     * Возвращает цель отрисовки игрового мира.
+     * Единицы измерения - пиксели игрового мира.
+     */
+    sf::RenderTarget& gameTarget() noexcept;
     sf::RenderWindow& debugWindow() noexcept;
+    /*!
+     * Выводит в окно кадр игрового мира, увеличенный в целое число раз.
+     * Вызывается после отрисовки игрового мира и до отрисовки отладочной
+     * информации.
+     */
+    void drawFrame();
 
     /*!
      * \param[in] size Размер в пикселях.
      */
     void resize(const sf::Vector2u &size);
     sf::Vector2u windowSize() const noexcept;
-    const sf::Vector2f& viewSize() const noexcept;
 
-    void renderClippingMask(sf::RenderWindow &target);
+    /*!
+     * Задаёт масштаб увеличения кадра игрового мира.
+     * \param[in] scale Целочисленный множитель. Если равен 0 или не
+     * помещается в окно, то выбирается наибольший помещающийся множитель.
+     */
+    void setScale(unsigned int scale);
+    /*!
+     * Задаёт размер кадра игрового мира.
+     * Если кадр не помещается в окно, он выводится уменьшенным.
+     * \param[in] size Размер в пикселях игрового мира.
+     */
+    void setFrameSize(const sf::Vector2u &size);
 
     void toggleFullscreen();
 
     void enableDebugView(bool value);
+    /*!
+     * Включает ограничение частоты кадров значением FPS_LIMIT.
+     * По умолчанию включено.
+     * \param[in] value Ограничивать частоту кадров.
+     */
+    void enableFrameLimit(bool value);
 
 private:
     void setup(const std::string &title);
     void create();
     void destroy();
     void onKeyPressed(const sf::Event::KeyEvent &key);
-    void updateClippingMask(const float aspectRatio);
+    void updateFrameSprite();
 
 private:
     sf::RenderWindow m_window;
 
-    /// Единицы измерения размера - пиксели игрового мира.
+    /// Кадр игрового мира в его натуральном разрешении.
+    sf::RenderTexture m_frame;
+    /// Прямоугольник, через который кадр выводится в окно.
+    sf::Sprite m_frameSprite;
+    /// Масштаб, заданный пользователем. 0 - автоматический выбор.
+    unsigned int m_scale{ 0 };
+
+    /// Единицы измерения размера - пиксели экрана.
     sf::View m_view;
     /// Единицы измерения размера - пиксели экрана.
     std::optional<sf::View> m_viewDebug;
@@ -77,11 +110,5 @@ private:
 
     bool m_isDone{ false };
     bool m_isFullscreen{ false };
-
-    /// Маска из двух прямоугольников, прикрывающая объекты,
-    /// выходящие за пределы виртуального экрана.
-    /// TODO: использовать готовое решение в SFML 3:
-    /// https://github.com/SFML/SFML/pull/1451
-    sf::RectangleShape m_mask1;
-    sf::RectangleShape m_mask2;
+    bool m_frameLimit{ true };
 };
@@ -5,24 +5,35 @@
 #include <functional>
 #include <optional>
 #include <random>
-#include <set>
+#include <string>
+#include <vector>
 
+#include <boost/container/flat_set.hpp>
 #include <boost/signals2.hpp>
 
 #include <SFML/Graphics.hpp>
 
+#include <game/event_log.h>
+#include <game/leaderboard.h>
 #include <game/screen.h>
 #include <game/graphics/objects/box.h>
 #include <game/graphics/objects/crane.h>
 #include <game/graphics/objects/player.h>
 #include <game/graphics/score.h>
+#include <game/graphics/sprite_sink.h>
+#include <game/replay.h>
 #include <game/resource_loader.h>
+#include <game/sound_sink.h>
 
 
 namespace
 {
 
 constexpr std::size_t MAX_CRANES_QUANTITY = 5;
+/// Наибольшее количество ящиков в игре: все клетки поля, ещё один ряд
+/// падающих ящиков и ящики кранов.
+constexpr std::size_t MAX_BOXES_QUANTITY =
+    (BOXES_ROWS + 1) * BOXES_COLUMNS + MAX_CRANES_QUANTITY;
 
 }
 
@@ -33,31 +44,118 @@ struct InitialPosition;
 class World final : public Screen
 {
     friend class ScreenDebug;
+    friend class WorldInspector;
 
 public:
     using Signal = boost::signals2::signal<void()>;
     using Slot = Signal::slot_type;
 
+    /// Состояние идущей игры, скопированное makeSnapshot().
+    struct Snapshot
+    {
+        /// Номер игры в журнале событий. Меняется с началом новой игры.
+        std::uint64_t gameId{ 0 };
+        std::uint32_t tick{ 0 };
+        std::uint32_t score{ 0 };
+        bool paused{ false };
+        bool godMode{ false };
+        Player::Direction playerRequestedDirection{ Player::Direction::None };
+        std::mt19937 randomEngine;
+        /// Объекты мира в двоичном виде.
+        std::string objects;
+    };
+
+private:
+    using Boxes = std::map<Object::Id, BoxPtr>;
+
 public:
     explicit World();
     void start(
         const std::optional<unsigned int> &positionIndex = std::nullopt);
+    /*!
+     * Начинает игру с начальными условиями записанной игры.
+     * Чтобы повторить игру, перед каждым обновлением мира следует
+     * передать ему нажатия клавиш из записи с тем же номером обновления.
+     * Режим отладки восстанавливается из записи.
+     * Количество кранов не ограничивается MAX_INITIAL_CRANES_QUANTITY.
+     * \param[in] replay Запись игры.
+     */
+    void start(const Replay &replay);
     void setDebugMode(bool value);
+    /*!
+     * Задаёт получателя звуков мира. По умолчанию звуки
+     * не воспроизводятся (NullSoundSink), чтобы миры без окна
+     * не создавали звуковую подсистему.
+     * \param[in] sink Получатель звуков.
+     */
+    void setSoundSink(SoundSink &sink);
+    /*!
+     * Задаёт имя игрока, под которым результат игры заносится
+     * в таблицу рекордов. Без имени результат не заносится.
+     * \param[in] name Имя игрока.
+     * \param[in] board Таблица рекордов.
+     */
+    void setPlayerName(
+        const std::string &name,
+        Leaderboard::Board board = Leaderboard::Board::Players);
     void update(const Duration &elapsed) override;
     bool handleKeyPressed(const sf::Keyboard::Key key) override;
     void handleKeyReleased(const sf::Keyboard::Key key) override;
     void draw(
         sf::RenderTarget &target,
         sf::RenderStates states) const override;
+    /*!
+     * Выводит ту же сцену, что и draw(), в получатель спрайтов.
+     * Порядок вывода должен совпадать с порядком в draw().
+     * \param[in] sink Получатель спрайтов.
+     */
+    void drawSprites(SpriteSink &sink) const;
+    /// \return Количество вызовов отрисовки, выполненных последним draw().
+    std::size_t drawCalls() const noexcept;
 
     boost::signals2::connection connectClose(const Slot &slot);
+    boost::signals2::connection connectGameOver(const Slot &slot);
     void requestMovePlayer(const Player::Direction direction);
     void requestStopPlayer();
     void togglePause();
     unsigned int score() const noexcept;
+    bool gameOver() const noexcept;
+    /*!
+     * Записывает состояние идущей игры в двоичном виде.
+     * \param[in] stream Получатель данных.
+     */
+    void save(std::ostream &stream) const;
+    /*!
+     * Копирует состояние идущей игры без записи игры. Копирование
+     * дешевле save() и выполняется в игровом потоке, а перевод снимка
+     * в формат save() можно выполнить в другом потоке.
+     * \param[out] snapshot Снимок. Прежнее содержимое заменяется.
+     */
+    void makeSnapshot(Snapshot &snapshot) const;
+    /*!
+     * Записывает снимок в том же виде, что и save().
+     * \param[in] stream Получатель данных.
+     * \param[in] replay Запись игры, для которой сделан снимок.
+     * \param[in] snapshot Снимок, сделанный makeSnapshot().
+     */
+    static void save(std::ostream &stream, const Replay &replay, const Snapshot &snapshot);
+    /*!
+     * Продолжает игру, состояние которой записано save().
+     * Идентификаторы объектов назначаются заново.
+     * \param[in] stream Источник данных.
+     * \return \c false, если данные повреждены. В этом случае мир
+     * следует начать заново.
+     */
+    bool restore(std::istream &stream);
+    /// Запись текущей игры.
+    const Replay& replay() const noexcept;
 
 private:
     void setup();
+    void start(
+        const std::optional<unsigned int> &positionIndex,
+        std::uint32_t seed,
+        std::uint8_t cranesQuantity);
     void resume();
     void pause();
     void clearObjects();
@@ -80,7 +178,22 @@ private:
      */
     Coordinate initialPlayerColumn() const;
     BoxPtr makeBox();
+    /*!
+     * Добавляет ящик в игру. Ящик берётся из пула, а если пул пуст,
+     * создаётся.
+     * \param[in] restStyle Номер варианта внешнего вида покоящегося ящика.
+     * \return Добавленный ящик.
+     */
+    BoxPtr makeBox(std::size_t restStyle);
+    /*!
+     * Убирает ящик из игры в пул.
+     * Индексы ящиков не изменяются.
+     * \param[in] boxId Идентификатор ящика.
+     */
+    void releaseBox(Object::Id boxId);
     BoxPtr addBox(Coordinate row, Coordinate column);
+    /// \return Кран из пула или, если пул пуст, новый кран.
+    CranePtr makeCrane();
     void addCranes(uint8_t cranesQuantity);
     /*!
      * Логика управления кранами, выработанная экспериментально.
@@ -183,7 +296,8 @@ private:
      * \return Количество неподвижных ящиков.
      */
     Coordinate columnHeight(Coordinate column) const noexcept;
-    void renderCrane(Crane &crane, sf::RenderTarget &target) const;
+    /// \return Количество вызовов отрисовки.
+    std::size_t renderCrane(Crane &crane, sf::RenderTarget &target) const;
     /*!
      * Возвращает высоту, на которой должен остановиться падающий ящик.
      * \param[in] box Падающий ящик.
@@ -205,6 +319,16 @@ private:
     std::optional<Object::Id> levitationBoxId(
         Coordinate column) const noexcept;
     void playSound(ResourceLoader::SoundId id);
+    /*!
+     * Добавляет событие в журнал событий, если он открыт.
+     * Значения аргументов зависят от типа события.
+     * \sa EventLog::Type
+     */
+    void logEvent(
+        EventLog::Type type,
+        std::uint8_t argument0,
+        std::uint16_t argument1,
+        std::uint32_t argument2) const;
     void stop();
     void exit();
 
@@ -212,19 +336,29 @@ private:
     std::function<void(const Duration&)> m_updater;
 
     Signal m_signalClose;
+    Signal m_signalGameOver;
 
     Player m_player;
     Player::Direction m_playerRequestedDirection{ Player::Direction::None };
 
-    std::map<Object::Id, BoxPtr> m_boxes;
+    Boxes m_boxes;
     // Индексация ящиков.
     /// Ящики, лежащие на полу.
     std::array<std::array<Object::Id, BOXES_ROWS>, BOXES_COLUMNS> m_boxesStatic;
     /// Ящики, находящиеся в движении, кроме удерживаемых кранами.
-    std::set<Object::Id> m_boxesMoving;
+    boost::container::flat_set<Object::Id> m_boxesMoving;
+    /// Копия m_boxesMoving, по которой обходятся движущиеся ящики
+    /// при обновлении, т.к. m_boxesMoving может меняться при обходе.
+    std::vector<Object::Id> m_boxesMovingSnapshot;
 
     std::array<CranePtr, MAX_CRANES_QUANTITY> m_cranes;
 
+    // Пулы объектов, убранных из игры. Объекты создаются заранее
+    // и используются повторно, чтобы обновление мира не выделяло память.
+    /// Узлы m_boxes вместе с ящиками.
+    std::vector<Boxes::node_type> m_freeBoxes;
+    std::vector<CranePtr> m_freeCranes;
+
     sf::Sprite m_background;
     sf::Sprite m_foreground;
 
@@ -234,6 +368,8 @@ private:
     unsigned int m_score{ 0 };
     /// Графический примитив, отображающий счёт игры.
     ScorePtr m_scoreFigure;
+    /// Количество вызовов отрисовки, выполненных последним draw().
+    mutable std::size_t m_drawCalls{ 0 };
 
     bool m_paused{ true };
 
@@ -241,4 +377,14 @@ private:
     bool m_godMode{ false };
 
     mutable std::mt19937 m_randomEngine;
+
+    SoundSink *m_soundSink;
+    std::optional<std::string> m_playerName;
+    Leaderboard::Board m_leaderboard{ Leaderboard::Board::Players };
+
+    Replay m_replay;
+    /// Номер обновления мира с начала игры.
+    std::uint32_t m_tick{ 0 };
+    /// Номер игры в журнале событий.
+    std::uint64_t m_gameId{ 0 };
 };
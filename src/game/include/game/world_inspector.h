@@ -0,0 +1,88 @@
+#pragma once
+
+
+#include <game/world.h>
+
+
+/*!
+ * Доступ к внутреннему устройству игрового мира для инструментов
+ * разработки: измерения производительности и проверки инвариантов.
+ * Игрой не используется.
+ */
+class WorldInspector final
+{
+public:
+    WorldInspector() = delete;
+
+    /*!
+     * Начинает игру с заданными начальными условиями.
+     * \param[in] world Игровой мир.
+     * \param[in] positionIndex Номер начального положения из
+     * INITIAL_POSITIONS. Если не задан, положение случайное.
+     * \param[in] seed Начальное значение генератора случайных чисел.
+     * \param[in] cranesQuantity Количество кранов, до MAX_CRANES_QUANTITY.
+     * В отличие от игры, не ограничивается MAX_INITIAL_CRANES_QUANTITY.
+     */
+    static void start(
+        World &world,
+        const std::optional<unsigned int> &positionIndex,
+        std::uint32_t seed,
+        std::uint8_t cranesQuantity)
+    {
+        // Запись игры воспроизводит все краны, поэтому игра
+        // начинается через неё.
+        Replay replay;
+        replay.seed = seed;
+        replay.positionIndex = positionIndex;
+        replay.cranesQuantity = cranesQuantity;
+        world.start(replay);
+    }
+
+    static Coordinate columnHeight(const World &world, Coordinate column) noexcept
+    {
+        return world.columnHeight(column);
+    }
+
+    static bool canPlayerMove(
+        const World &world,
+        Coordinate row,
+        Coordinate column,
+        Player::Direction direction)
+    {
+        Object::Id pushedBoxId = NULL_ID;
+        return world.canPlayerMove(row, column, direction, pushedBoxId);
+    }
+
+    static float stackHeightUnderBox(const World &world, const Box &box)
+    {
+        return world.stackHeightUnderBox(box);
+    }
+
+    static bool canDropBox(const World &world, Object::Id boxId, Coordinate column)
+    {
+        return world.canDropBox(boxId, column);
+    }
+
+    static const std::map<Object::Id, BoxPtr>& boxes(const World &world) noexcept
+    {
+        return world.m_boxes;
+    }
+
+    /// \return Ящики, лежащие на полу, по колонкам снизу вверх.
+    static const std::array<std::array<Object::Id, BOXES_ROWS>, BOXES_COLUMNS>& boxesStatic(
+        const World &world) noexcept
+    {
+        return world.m_boxesStatic;
+    }
+
+    static const boost::container::flat_set<Object::Id>& boxesMoving(
+        const World &world) noexcept
+    {
+        return world.m_boxesMoving;
+    }
+
+    static const Player& player(const World &world) noexcept
+    {
+        return world.m_player;
+    }
+};
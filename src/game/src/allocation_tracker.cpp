@@ -0,0 +1,160 @@
+#include <game/allocation_tracker.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+namespace
+{
+
+/// Заголовок выделенного блока памяти с его размером.
+/// Выравнивание сохраняет выравнивание блока.
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+std::atomic<std::uint64_t> allocationsQuantity{ 0 };
+std::atomic<std::uint64_t> bytesQuantity{ 0 };
+std::atomic<std::int64_t> heapSize{ 0 };
+std::atomic<std::int64_t> heapPeakSize{ 0 };
+thread_local AllocationTracker::Counters threadCounters;
+
+
+#ifdef ALLOCATION_TRACKING_ENABLED
+void* allocate(std::size_t size) noexcept
+{
+    void *block = std::malloc(size + HEADER_SIZE);
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+    *static_cast<std::size_t*>(block) = size;
+
+    ++threadCounters.allocations;
+    threadCounters.bytes += size;
+    allocationsQuantity.fetch_add(1, std::memory_order_relaxed);
+    bytesQuantity.fetch_add(size, std::memory_order_relaxed);
+    const std::int64_t current =
+        heapSize.fetch_add(std::int64_t(size), std::memory_order_relaxed) + std::int64_t(size);
+    std::int64_t peak = heapPeakSize.load(std::memory_order_relaxed);
+    while (current > peak &&
+        !heapPeakSize.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+    {
+    }
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+
+void deallocate(void *pointer) noexcept
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    void *block = static_cast<char*>(pointer) - HEADER_SIZE;
+    heapSize.fetch_sub(
+        std::int64_t(*static_cast<std::size_t*>(block)),
+        std::memory_order_relaxed);
+    std::free(block);
+}
+#endif
+
+}
+
+
+AllocationTracker::Counters AllocationTracker::total() noexcept
+{
+    return Counters{
+        allocationsQuantity.load(std::memory_order_relaxed),
+        bytesQuantity.load(std::memory_order_relaxed) };
+}
+
+
+AllocationTracker::Counters AllocationTracker::thread() noexcept
+{
+    return threadCounters;
+}
+
+
+std::int64_t AllocationTracker::heapSize() noexcept
+{
+    return ::heapSize.load(std::memory_order_relaxed);
+}
+
+
+std::int64_t AllocationTracker::heapPeakSize() noexcept
+{
+    return ::heapPeakSize.load(std::memory_order_relaxed);
+}
+
+
+#ifdef ALLOCATION_TRACKING_ENABLED
+
+// Замена глобальных операторов. Варианты с выравниванием больше
+// стандартного не заменяются: стандартная библиотека выделяет
+// и освобождает такие блоки отдельно от остальных.
+
+void* operator new(std::size_t size)
+{
+    if (void *pointer = allocate(size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+
+void operator delete(void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+
+void operator delete[](void *pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+
+void operator delete(void *pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+
+void operator delete[](void *pointer, const std::nothrow_t&) noexcept
+{
+    deallocate(pointer);
+}
+
+#endif // ALLOCATION_TRACKING_ENABLED
@@ -1,13 +1,17 @@
 #include <game/animation.h>
+
+#include <algorithm>
+
 #include <game/log.h>
 
 
 Animator::Animator(
-    const sf::Texture &texture,
+    const sf::Vector2u &textureSize,
     const sf::Vector2u &spritesQuantity)
 {
-    m_currentRect.width = texture.getSize().x / float(spritesQuantity.y);
-    m_currentRect.height = texture.getSize().y / float(spritesQuantity.x);
+    m_currentRect.width = textureSize.x / float(spritesQuantity.y);
+    m_currentRect.height = textureSize.y / float(spritesQuantity.x);
+    m_currentAnimationSequence.reserve(ANIMATION_SEQUENCE_CAPACITY);
 }
 
 
@@ -18,14 +22,19 @@ void Animator::setAnimation(const AnimationOriented animation)
 
 
 void Animator::setAnimationSequence(
-    const std::vector<AnimationOriented> &sequence)
+    std::initializer_list<AnimationOriented> sequence)
 {
-    if (m_currentAnimationSequence == sequence)
+    if (std::equal(
+            m_currentAnimationSequence.cbegin(),
+            m_currentAnimationSequence.cend(),
+            sequence.begin(),
+            sequence.end()))
     {
         return;
     }
 
-    m_currentAnimationSequence = sequence;
+    // Присваивание не выделяет память, пока хватает ёмкости.
+    m_currentAnimationSequence.assign(sequence);
     if (!m_currentAnimationSequence.empty())
     {
         setAnimationIndex(0);
@@ -33,6 +42,19 @@ void Animator::setAnimationSequence(
 }
 
 
+void Animator::reset()
+{
+    m_currentAnimationIndex = 0;
+    m_currentAnimationSequence.clear();
+    m_currentSpriteIndex = 0;
+    m_currentRect.left = 0;
+    m_currentRect.top = 0;
+    m_currentRect.width = std::abs(m_currentRect.width);
+    m_forceUpdate = false;
+    m_currentSpriteTime = Duration(0);
+}
+
+
 unsigned int Animator::currentSpriteIndex() const noexcept
 {
     return m_currentSpriteIndex;
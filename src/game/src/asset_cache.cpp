@@ -0,0 +1,217 @@
+#include <game/asset_cache.h>
+
+#include <fstream>
+#include <random>
+
+#include <game/binary_io.h>
+#include <game/log.h>
+#include <game/mapped_file.h>
+
+
+namespace
+{
+
+/// Сигнатура записи кэша изображения.
+constexpr std::uint32_t IMAGE_MAGIC = 0x49434B53; // "SKCI"
+/// Сигнатура записи кэша звука.
+constexpr std::uint32_t SOUND_MAGIC = 0x53434B53; // "SKCS"
+/// Версия формата кэша. Увеличивается при любом изменении формата
+/// или способа декодирования ресурсов.
+constexpr std::uint32_t ASSET_CACHE_VERSION = 1;
+/// Размер заголовка записи. Данные следуют сразу за ним и выровнены.
+constexpr std::size_t HEADER_SIZE = 32;
+
+const std::string ENTRY_EXTENSION(".asset");
+
+
+/// Заголовок записи кэша.
+struct Header
+{
+    std::uint32_t magic{ 0 };
+    std::uint32_t version{ 0 };
+    std::uint64_t sourceHash{ 0 };
+    /// Ширина изображения или количество каналов звука.
+    std::uint32_t first{ 0 };
+    /// Высота изображения или частота дискретизации звука.
+    std::uint32_t second{ 0 };
+    /// Размер данных в байтах.
+    std::uint64_t dataSize{ 0 };
+};
+
+
+/*!
+ * Отображает запись кэша в память и проверяет её заголовок.
+ * \return \c false, если записи нет, она повреждена или устарела.
+ */
+bool openEntry(
+    const std::filesystem::path &path,
+    std::uint32_t magic,
+    std::uint64_t sourceHash,
+    MappedFile &file,
+    Header &header)
+{
+    std::error_code error;
+    if (!std::filesystem::exists(path, error) || !file.open(path))
+    {
+        return false;
+    }
+
+    const std::uint8_t *cursor = file.data();
+    const std::uint8_t *end = file.data() + file.size();
+    const bool ok =
+        readLittleEndian(cursor, end, header.magic) &&
+        readLittleEndian(cursor, end, header.version) &&
+        readLittleEndian(cursor, end, header.sourceHash) &&
+        readLittleEndian(cursor, end, header.first) &&
+        readLittleEndian(cursor, end, header.second) &&
+        readLittleEndian(cursor, end, header.dataSize);
+    if (!ok ||
+        header.magic != magic ||
+        header.version != ASSET_CACHE_VERSION ||
+        header.sourceHash != sourceHash ||
+        header.dataSize != file.size() - HEADER_SIZE)
+    {
+        LOG_DEBUG("Asset cache entry " << path << " is stale.");
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+
+/*!
+ * Записывает запись кэша во временный файл и заменяет им прежнюю запись,
+ * чтобы одновременно запущенные экземпляры игры не прочитали
+ * частично записанный файл.
+ */
+void writeEntry(
+    const std::filesystem::path &path,
+    const Header &header,
+    const void *data)
+{
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += "." + std::to_string(std::random_device()()) + ".tmp";
+    {
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        BinaryWriter writer(stream);
+        writer.write(header.magic);
+        writer.write(header.version);
+        writer.write(header.sourceHash);
+        writer.write(header.first);
+        writer.write(header.second);
+        writer.write(header.dataSize);
+        stream.write(static_cast<const char*>(data), std::streamsize(header.dataSize));
+        if (!stream.flush())
+        {
+            LOG_WARNING("Failed to write asset cache entry " << path << ".");
+            stream.close();
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        LOG_WARNING("Failed to write asset cache entry " << path << ": " << error.message() << ".");
+        std::filesystem::remove(temporaryPath, error);
+    }
+}
+
+}
+
+
+AssetCache::AssetCache(const std::filesystem::path &directory)
+    : m_directory(directory)
+{
+}
+
+
+std::uint64_t AssetCache::hash(const std::uint8_t *data, std::size_t size) noexcept
+{
+    std::uint64_t result = 0xCBF29CE484222325;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result ^= data[i];
+        result *= 0x100000001B3;
+    }
+    return result;
+}
+
+
+ImagePtr AssetCache::loadImage(const std::string &name, std::uint64_t sourceHash) const
+{
+    MappedFile file;
+    Header header;
+    if (!openEntry(entryPath(name), IMAGE_MAGIC, sourceHash, file, header) ||
+        header.dataSize != std::uint64_t(header.first) * header.second * 4)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<sf::Image> image = std::make_shared<sf::Image>();
+    image->create(header.first, header.second, file.data() + HEADER_SIZE);
+    return image;
+}
+
+
+SoundSamplesPtr AssetCache::loadSound(const std::string &name, std::uint64_t sourceHash) const
+{
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    Header header;
+    if (!openEntry(entryPath(name), SOUND_MAGIC, sourceHash, *file, header) ||
+        header.dataSize % sizeof(sf::Int16) != 0)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<SoundSamples> sound = std::make_shared<SoundSamples>();
+    sound->samples = reinterpret_cast<const sf::Int16*>(file->data() + HEADER_SIZE);
+    sound->samplesQuantity = std::size_t(header.dataSize / sizeof(sf::Int16));
+    sound->channelCount = header.first;
+    sound->sampleRate = header.second;
+    sound->storage = file;
+    return sound;
+}
+
+
+void AssetCache::storeImage(
+    const std::string &name,
+    std::uint64_t sourceHash,
+    const sf::Image &image) const
+{
+    Header header;
+    header.magic = IMAGE_MAGIC;
+    header.version = ASSET_CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.first = image.getSize().x;
+    header.second = image.getSize().y;
+    header.dataSize = std::uint64_t(header.first) * header.second * 4;
+    writeEntry(entryPath(name), header, image.getPixelsPtr());
+}
+
+
+void AssetCache::storeSound(
+    const std::string &name,
+    std::uint64_t sourceHash,
+    const SoundSamples &sound) const
+{
+    Header header;
+    header.magic = SOUND_MAGIC;
+    header.version = ASSET_CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.first = sound.channelCount;
+    header.second = sound.sampleRate;
+    header.dataSize = sound.samplesQuantity * sizeof(sf::Int16);
+    writeEntry(entryPath(name), header, sound.samples);
+}
+
+
+std::filesystem::path AssetCache::entryPath(const std::string &name) const
+{
+    // Имя ресурса "graphics/box.png" превращается в "graphics/box.png.asset".
+    return m_directory / (name + ENTRY_EXTENSION);
+}
@@ -0,0 +1,86 @@
+#include <game/atomic_file.h>
+
+#include <cstdio>
+#include <system_error>
+#include <tuple>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <game/log.h>
+
+
+namespace
+{
+
+const std::string TEMPORARY_EXTENSION = ".tmp";
+
+
+/// Записывает файл и дожидается, пока данные окажутся на диске.
+bool writeDurably(const std::filesystem::path &path, const std::string &data)
+{
+#ifdef _WIN32
+    std::FILE *file = _wfopen(path.c_str(), L"wb");
+#else
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+#endif
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool result =
+        std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+        std::fflush(file) == 0;
+#ifdef _WIN32
+    result = result && _commit(_fileno(file)) == 0;
+#else
+    result = result && fsync(fileno(file)) == 0;
+#endif
+    return std::fclose(file) == 0 && result;
+}
+
+
+/// Сбрасывает на диск запись каталога, чтобы переименование пережило сбой.
+void syncDirectory(const std::filesystem::path &directory)
+{
+#ifdef _WIN32
+    std::ignore = directory;
+#else
+    const int descriptor = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (descriptor >= 0)
+    {
+        fsync(descriptor);
+        ::close(descriptor);
+    }
+#endif
+}
+
+}
+
+
+bool writeFileAtomically(const std::filesystem::path &path, const std::string &data)
+{
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += TEMPORARY_EXTENSION;
+    std::error_code error;
+    if (!writeDurably(temporaryPath, data))
+    {
+        LOG_ERROR("Failed to write " << temporaryPath << ".");
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        LOG_ERROR("Failed to rename " << temporaryPath << " to " << path << ": "
+            << error.message() << ".");
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    syncDirectory(path.parent_path());
+    return true;
+}
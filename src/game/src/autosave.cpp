@@ -0,0 +1,443 @@
+#include <game/autosave.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <game/asset_cache.h>
+#include <game/atomic_file.h>
+#include <game/binary_io.h>
+#include <game/log.h>
+#include <game/tracer.h>
+
+
+namespace
+{
+
+/// Период автосохранения.
+constexpr std::chrono::seconds AUTOSAVE_PERIOD(5);
+/// Файл-признак работы игры.
+const std::filesystem::path RUNNING_MARKER("running");
+const std::string FILE_PREFIX = "autosave_";
+const std::string FILE_EXTENSION = ".bin";
+
+/// Сигнатура файла автосохранения.
+constexpr std::uint32_t AUTOSAVE_MAGIC = 0x53414B53; // "SKAS"
+/// Версия формата файла автосохранения.
+constexpr std::uint16_t AUTOSAVE_VERSION = 1;
+/// Заголовок: сигнатура, версия, резерв, размер снимка, хэш снимка.
+constexpr std::size_t HEADER_SIZE = 4 + 2 + 2 + 4 + 8;
+
+/// Повторы короче этого хранятся как есть.
+constexpr std::size_t MIN_RUN = 3;
+constexpr std::size_t MAX_RUN = 0x7F + MIN_RUN;
+constexpr std::size_t MAX_LITERALS = 0x80;
+
+
+/*!
+ * Сжимает данные кодированием длин серий.
+ * Управляющий байт c < 0x80 предваряет c + 1 байтов как есть,
+ * c >= 0x80 - повтор следующего байта c - 0x80 + MIN_RUN раз.
+ * Снимок мира в основном состоит из нулевых старших байтов чисел,
+ * которые хорошо сжимаются таким способом.
+ */
+std::string compress(const std::string &data)
+{
+    std::string result;
+    result.reserve(data.size() / 2);
+    std::size_t literalsBegin = 0;
+    const auto writeLiterals = [&data, &result, &literalsBegin](std::size_t end)
+    {
+        while (literalsBegin < end)
+        {
+            const std::size_t quantity = std::min(end - literalsBegin, MAX_LITERALS);
+            result.push_back(char(quantity - 1));
+            result.append(data, literalsBegin, quantity);
+            literalsBegin += quantity;
+        }
+    };
+
+    std::size_t i = 0;
+    while (i < data.size())
+    {
+        std::size_t run = 1;
+        while (i + run < data.size() && run < MAX_RUN && data[i + run] == data[i])
+        {
+            ++run;
+        }
+        if (run >= MIN_RUN)
+        {
+            writeLiterals(i);
+            result.push_back(char(0x80 + run - MIN_RUN));
+            result.push_back(data[i]);
+            literalsBegin = i + run;
+        }
+        i += run;
+    }
+    writeLiterals(data.size());
+    return result;
+}
+
+
+std::optional<std::string> decompress(
+    const std::uint8_t *cursor,
+    const std::uint8_t *end,
+    std::size_t size)
+{
+    std::string result;
+    result.reserve(size);
+    while (cursor < end && result.size() <= size)
+    {
+        const std::uint8_t control = *cursor++;
+        if (control < 0x80)
+        {
+            const std::size_t quantity = std::size_t(control) + 1;
+            if (std::size_t(end - cursor) < quantity)
+            {
+                return std::nullopt;
+            }
+            result.append(reinterpret_cast<const char*>(cursor), quantity);
+            cursor += quantity;
+        }
+        else
+        {
+            if (cursor == end)
+            {
+                return std::nullopt;
+            }
+            result.append(control - 0x80 + MIN_RUN, char(*cursor++));
+        }
+    }
+    if (result.size() != size)
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+
+std::uint64_t hash(const std::string &data)
+{
+    return AssetCache::hash(
+        reinterpret_cast<const std::uint8_t*>(data.data()),
+        data.size());
+}
+
+
+std::filesystem::path generationPath(
+    const std::filesystem::path &directory,
+    std::uint64_t generation)
+{
+    return directory / (FILE_PREFIX + std::to_string(generation) + FILE_EXTENSION);
+}
+
+
+/// \return Номера поколений автосохранений в каталоге по возрастанию.
+std::vector<std::uint64_t> generations(const std::filesystem::path &directory)
+{
+    std::vector<std::uint64_t> result;
+    std::error_code error;
+    for (const std::filesystem::directory_entry &entry :
+        std::filesystem::directory_iterator(directory, error))
+    {
+        const std::string name = entry.path().filename().string();
+        if (name.size() <= FILE_PREFIX.size() + FILE_EXTENSION.size() ||
+            name.compare(0, FILE_PREFIX.size(), FILE_PREFIX) != 0 ||
+            entry.path().extension() != FILE_EXTENSION)
+        {
+            continue;
+        }
+        const std::string number = name.substr(
+            FILE_PREFIX.size(),
+            name.size() - FILE_PREFIX.size() - FILE_EXTENSION.size());
+        if (std::all_of(
+                number.cbegin(),
+                number.cend(),
+                [](unsigned char c) { return std::isdigit(c) != 0; }))
+        {
+            result.push_back(std::stoull(number));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+std::optional<std::string> readSnapshot(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    const std::string data(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    const std::uint8_t *cursor = reinterpret_cast<const std::uint8_t*>(data.data());
+    const std::uint8_t *end = cursor + data.size();
+
+    std::uint32_t magic{ 0 };
+    std::uint16_t version{ 0 };
+    std::uint16_t reserved{ 0 };
+    std::uint32_t size{ 0 };
+    std::uint64_t snapshotHash{ 0 };
+    if (data.size() < HEADER_SIZE ||
+        !readLittleEndian(cursor, end, magic) ||
+        !readLittleEndian(cursor, end, version) ||
+        !readLittleEndian(cursor, end, reserved) ||
+        !readLittleEndian(cursor, end, size) ||
+        !readLittleEndian(cursor, end, snapshotHash) ||
+        magic != AUTOSAVE_MAGIC ||
+        version != AUTOSAVE_VERSION)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<std::string> snapshot = decompress(cursor, end, size);
+    if (!snapshot.has_value() || hash(snapshot.value()) != snapshotHash)
+    {
+        return std::nullopt;
+    }
+    return snapshot;
+}
+
+}
+
+
+Autosave::Autosave(const std::filesystem::path &directory)
+    : m_directory(directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+    {
+        LOG_ERROR(
+            "Failed to create directory " << m_directory
+            << ": " << error.message() << '.');
+    }
+    std::ofstream(m_directory / RUNNING_MARKER, std::ios::trunc);
+
+    const std::vector<std::uint64_t> existing = generations(m_directory);
+    m_generation = existing.empty() ? 0 : existing.back();
+
+    // Запускается после создания всех членов класса.
+    m_thread = std::thread(&Autosave::run, this);
+}
+
+
+Autosave::~Autosave()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+
+    std::error_code error;
+    std::filesystem::remove(m_directory / RUNNING_MARKER, error);
+}
+
+
+void Autosave::update(const World &world, const Duration &elapsed)
+{
+    if (world.gameOver())
+    {
+        return;
+    }
+    m_sinceSnapshot += elapsed;
+    if (m_sinceSnapshot < AUTOSAVE_PERIOD)
+    {
+        return;
+    }
+    m_sinceSnapshot = Duration(0);
+
+    // В игровом потоке копируется только состояние мира и новые события
+    // записи игры, а вся запись переводится в двоичный вид фоновым потоком.
+    Pending pending;
+    world.makeSnapshot(pending.world);
+    const Replay &replay = world.replay();
+    pending.restart = pending.world.gameId != m_gameId;
+    if (pending.restart)
+    {
+        m_gameId = pending.world.gameId;
+        m_sentInputs = 0;
+        m_sentIntervals = 0;
+        pending.replay.seed = replay.seed;
+        pending.replay.positionIndex = replay.positionIndex;
+        pending.replay.cranesQuantity = replay.cranesQuantity;
+    }
+    pending.replay.debugMode = replay.debugMode;
+    // Последний переданный интервал мог с тех пор удлиниться.
+    pending.firstInterval = m_sentIntervals == 0 ? 0 : m_sentIntervals - 1;
+    pending.replay.inputs.assign(
+        replay.inputs.cbegin() + std::ptrdiff_t(m_sentInputs),
+        replay.inputs.cend());
+    pending.replay.intervals.assign(
+        replay.intervals.cbegin() + std::ptrdiff_t(pending.firstInterval),
+        replay.intervals.cend());
+    m_sentInputs = replay.inputs.size();
+    m_sentIntervals = replay.intervals.size();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending.has_value() && !pending.restart)
+        {
+            // Фоновый поток ещё не забрал прошлый снимок:
+            // события обоих снимков передаются вместе.
+            Pending &previous = m_pending.value();
+            previous.world = std::move(pending.world);
+            previous.replay.debugMode = pending.replay.debugMode;
+            previous.replay.inputs.insert(
+                previous.replay.inputs.cend(),
+                pending.replay.inputs.cbegin(),
+                pending.replay.inputs.cend());
+            previous.replay.intervals.resize(
+                pending.firstInterval - previous.firstInterval);
+            previous.replay.intervals.insert(
+                previous.replay.intervals.cend(),
+                pending.replay.intervals.cbegin(),
+                pending.replay.intervals.cend());
+        }
+        else
+        {
+            m_pending = std::move(pending);
+        }
+    }
+    m_condition.notify_one();
+}
+
+
+void Autosave::discard()
+{
+    m_sinceSnapshot = Duration(0);
+    m_gameId = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.reset();
+        m_discardRequested = true;
+    }
+    m_condition.notify_one();
+}
+
+
+bool Autosave::uncleanExit(const std::filesystem::path &directory)
+{
+    std::error_code error;
+    return std::filesystem::exists(directory / RUNNING_MARKER, error);
+}
+
+
+std::optional<std::string> Autosave::readNewest(const std::filesystem::path &directory)
+{
+    const std::vector<std::uint64_t> existing = generations(directory);
+    for (auto it = existing.crbegin(); it != existing.crend(); ++it)
+    {
+        const std::filesystem::path path = generationPath(directory, *it);
+        std::optional<std::string> snapshot = readSnapshot(path);
+        if (snapshot.has_value())
+        {
+            LOG_INFO("Autosave " << path << " has been read.");
+            return snapshot;
+        }
+        LOG_WARNING("Autosave " << path << " is corrupted.");
+    }
+    return std::nullopt;
+}
+
+
+void Autosave::run()
+{
+    Tracer::instance().setThreadName("autosave");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_condition.wait(
+            lock,
+            [this]() { return m_pending.has_value() || m_discardRequested || m_stopping; });
+
+        if (m_discardRequested)
+        {
+            m_discardRequested = false;
+            lock.unlock();
+            removeGenerations(m_generation + 1);
+            lock.lock();
+        }
+        if (m_pending.has_value())
+        {
+            const Pending pending = std::move(m_pending.value());
+            m_pending.reset();
+            lock.unlock();
+            write(pending);
+            lock.lock();
+        }
+        if (m_stopping && !m_pending.has_value() && !m_discardRequested)
+        {
+            return;
+        }
+    }
+}
+
+
+void Autosave::write(const Pending &pending)
+{
+    TRACE_SCOPE("Autosave::write");
+    if (pending.restart)
+    {
+        m_replay = pending.replay;
+    }
+    else
+    {
+        m_replay.debugMode = pending.replay.debugMode;
+        m_replay.inputs.insert(
+            m_replay.inputs.cend(),
+            pending.replay.inputs.cbegin(),
+            pending.replay.inputs.cend());
+        m_replay.intervals.resize(pending.firstInterval);
+        m_replay.intervals.insert(
+            m_replay.intervals.cend(),
+            pending.replay.intervals.cbegin(),
+            pending.replay.intervals.cend());
+    }
+    std::ostringstream snapshotStream;
+    World::save(snapshotStream, m_replay, pending.world);
+    const std::string snapshot = snapshotStream.str();
+
+    std::ostringstream stream;
+    BinaryWriter writer(stream);
+    writer.write(AUTOSAVE_MAGIC);
+    writer.write(AUTOSAVE_VERSION);
+    writer.write(std::uint16_t(0));
+    writer.write(std::uint32_t(snapshot.size()));
+    writer.write(hash(snapshot));
+    stream << compress(snapshot);
+
+    const std::uint64_t generation = m_generation + 1;
+    const std::filesystem::path path = generationPath(m_directory, generation);
+    if (!writeFileAtomically(path, stream.str()))
+    {
+        LOG_ERROR("Failed to write autosave " << path << ".");
+        return;
+    }
+
+    m_generation = generation;
+    if (m_generation >= AUTOSAVE_GENERATIONS)
+    {
+        removeGenerations(m_generation - AUTOSAVE_GENERATIONS + 1);
+    }
+    LOG_DEBUG(
+        "Autosave " << path << " has been written, "
+        << snapshot.size() << " bytes compressed to "
+        << stream.str().size() - HEADER_SIZE << '.');
+}
+
+
+void Autosave::removeGenerations(std::uint64_t first)
+{
+    std::error_code error;
+    for (const std::uint64_t generation : generations(m_directory))
+    {
+        if (generation < first)
+        {
+            std::filesystem::remove(generationPath(m_directory, generation), error);
+        }
+    }
+}
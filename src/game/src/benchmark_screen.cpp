@@ -0,0 +1,88 @@
+#include <game/benchmark_screen.h>
+
+#include <game/log.h>
+#include <game/window.h>
+
+
+namespace
+{
+
+constexpr sf::Keyboard::Key KEY_BACK = sf::Keyboard::Key::Escape;
+/// Интервал обновления мира. Не зависит от длительности кадра,
+/// чтобы игра не менялась вместе с ней.
+const Duration TICK(1.0 / FPS_LIMIT);
+
+}
+
+
+// Краны сверх MAX_INITIAL_CRANES_QUANTITY добавляются при начале игры
+// по записи (World::start(const Replay&)).
+const std::vector<BenchmarkScenario> BENCHMARK_SCENARIOS
+{
+    BenchmarkScenario{ "basic", "1 crane, empty board", 7, 1, 1 },
+    BenchmarkScenario{ "cranes", "5 cranes, stacks of 2-5 boxes", 3, 5, 1 },
+    BenchmarkScenario{ "rows", "5 cranes, full board with gaps, rows are blown often", 5, 5, 1 },
+};
+
+
+BenchmarkScreen::BenchmarkScreen(const BenchmarkScenario &scenario)
+    : m_scenario(scenario)
+    , m_bot(scenario.seed)
+{
+    start();
+    LOG_INFO(
+        "Benchmark scenario \"" << m_scenario.name << "\": "
+        << m_scenario.description << '.');
+}
+
+
+void BenchmarkScreen::update(const Duration&)
+{
+    if (m_world.gameOver())
+    {
+        start();
+    }
+    m_bot.update(m_world, TICK);
+    m_world.update(TICK);
+}
+
+
+bool BenchmarkScreen::handleKeyPressed(const sf::Keyboard::Key key)
+{
+    // Игрок не управляет игрой, чтобы не нарушить сценарий.
+    if (key == KEY_BACK)
+    {
+        m_signalClose();
+        return true;
+    }
+    return false;
+}
+
+
+void BenchmarkScreen::draw(sf::RenderTarget &target, sf::RenderStates states) const
+{
+    target.draw(m_world, states);
+}
+
+
+boost::signals2::connection BenchmarkScreen::connectClose(const Slot &slot)
+{
+    return m_signalClose.connect(slot);
+}
+
+
+std::size_t BenchmarkScreen::drawCalls() const noexcept
+{
+    return m_world.drawCalls();
+}
+
+
+void BenchmarkScreen::start()
+{
+    Replay replay;
+    replay.seed = m_scenario.seed;
+    replay.positionIndex = m_scenario.positionIndex;
+    replay.cranesQuantity = m_scenario.cranesQuantity;
+    m_world.start(replay);
+    m_bot = RandomBot(m_scenario.seed);
+}
@@ -0,0 +1,61 @@
+#include <game/bot.h>
+
+#include <array>
+
+#include <game/world.h>
+
+
+namespace
+{
+
+/// Клавиши, которые нажимает бот.
+const std::array<sf::Keyboard::Key, 5> BOT_KEYS
+{
+    sf::Keyboard::Key::Left,
+    sf::Keyboard::Key::Right,
+    sf::Keyboard::Key::Up,
+    sf::Keyboard::Key::Q,
+    sf::Keyboard::Key::E
+};
+/// Наименьший интервал между решениями бота, в секундах.
+constexpr double MIN_DECISION_INTERVAL = 0.05;
+/// Наибольший интервал между решениями бота, в секундах.
+constexpr double MAX_DECISION_INTERVAL = 0.5;
+
+}
+
+
+RandomBot::RandomBot(std::uint32_t seed)
+    : m_randomEngine(seed)
+{
+}
+
+
+void RandomBot::update(World &world, const Duration &elapsed)
+{
+    m_delay -= elapsed;
+    if (m_delay > Duration())
+    {
+        return;
+    }
+
+    std::uniform_real_distribution<double> distributionDelay(
+        MIN_DECISION_INTERVAL,
+        MAX_DECISION_INTERVAL);
+    m_delay = Duration(distributionDelay(m_randomEngine));
+
+    if (m_key.has_value())
+    {
+        world.handleKeyReleased(m_key.value());
+        m_key = std::nullopt;
+    }
+
+    // Одно из решений - ничего не нажимать.
+    std::uniform_int_distribution<std::size_t> distributionKey(0, BOT_KEYS.size());
+    const std::size_t index = distributionKey(m_randomEngine);
+    if (index < BOT_KEYS.size())
+    {
+        m_key = BOT_KEYS[index];
+        world.handleKeyPressed(m_key.value());
+    }
+}
@@ -6,3 +6,36 @@ Config& Config::instance()
     static Config singleton;
     return singleton;
 }
+
+
+void Config::setValues(const Values &values)
+{
+    setCranesQuantity(values.cranesQuantity);
+    setSound(values.sound);
+    setScreenScale(values.screenScale);
+    setRecordReplays(values.recordReplays);
+}
+
+
+void Config::setCranesQuantity(std::uint8_t value)
+{
+    set(m_values.cranesQuantity, value);
+}
+
+
+void Config::setSound(bool value)
+{
+    set(m_values.sound, value);
+}
+
+
+void Config::setScreenScale(unsigned int value)
+{
+    set(m_values.screenScale, value);
+}
+
+
+void Config::setRecordReplays(bool value)
+{
+    set(m_values.recordReplays, value);
+}
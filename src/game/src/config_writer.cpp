@@ -0,0 +1,88 @@
+#include <game/config_writer.h>
+
+#include <game/serializer.h>
+#include <game/tracer.h>
+
+
+namespace
+{
+
+/// Пауза в изменениях, после которой настройки записываются.
+constexpr std::chrono::milliseconds COALESCE_DELAY(500);
+
+}
+
+
+ConfigWriter::ConfigWriter()
+{
+    // Запускается после создания всех членов класса.
+    m_thread = std::thread(&ConfigWriter::run, this);
+}
+
+
+ConfigWriter::~ConfigWriter()
+{
+    update();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+
+void ConfigWriter::update()
+{
+    Config &config = Config::instance();
+    if (!config.dirty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = config.values();
+        ++m_changesQuantity;
+    }
+    config.setDirty(false);
+    m_condition.notify_one();
+}
+
+
+void ConfigWriter::run()
+{
+    Tracer::instance().setThreadName("config writer");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_condition.wait(
+            lock,
+            [this]() { return m_pending.has_value() || m_stopping; });
+
+        // Ожидание, пока изменения не прекратятся.
+        std::uint64_t changesQuantity = 0;
+        do
+        {
+            changesQuantity = m_changesQuantity;
+            m_condition.wait_for(lock, COALESCE_DELAY, [this]() { return m_stopping; });
+        }
+        while (changesQuantity != m_changesQuantity && !m_stopping);
+
+        if (m_pending.has_value())
+        {
+            const Config::Values values = m_pending.value();
+            m_pending.reset();
+            lock.unlock();
+            {
+                TRACE_SCOPE("writeConfig");
+                writeConfig(values);
+            }
+            lock.lock();
+        }
+        if (m_stopping)
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,216 @@
+#include <game/event_log.h>
+
+#include <game/binary_io.h>
+#include <game/clock.h>
+#include <game/log.h>
+
+
+namespace
+{
+
+/// Сигнатура журнала событий.
+constexpr std::uint32_t EVENT_LOG_MAGIC = 0x56454B53; // "SKEV"
+/// Версия формата журнала событий.
+constexpr std::uint16_t EVENT_LOG_VERSION = 1;
+/// Период, с которым буфер потока записывается в файл,
+/// даже если он не заполнен.
+constexpr std::chrono::seconds FLUSH_PERIOD(1);
+/// Через сколько записей проверяется, не пора ли записать буфер.
+constexpr std::size_t FLUSH_CHECK_PERIOD = 64;
+
+
+template<typename T>
+void encode(char *&cursor, T value)
+{
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        *cursor++ = char(std::uint8_t(std::uint64_t(value) >> (8 * i)));
+    }
+}
+
+}
+
+
+/// Буфер записей одного потока.
+class EventLog::ThreadBuffer final
+{
+public:
+    explicit ThreadBuffer(EventLog &log)
+        : m_log(log)
+        , m_lastFlush(Clock::now())
+    {
+        m_records.reserve(EVENT_LOG_BLOCK_RECORDS);
+    }
+
+    ~ThreadBuffer()
+    {
+        flush();
+    }
+
+    void push(const Record &record)
+    {
+        m_records.push_back(record);
+        if (m_records.size() == EVENT_LOG_BLOCK_RECORDS ||
+            (m_records.size() % FLUSH_CHECK_PERIOD == 0 &&
+                Clock::now() - m_lastFlush >= FLUSH_PERIOD))
+        {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if (!m_records.empty())
+        {
+            m_log.writeBlock(m_records.data(), m_records.size());
+            m_records.clear();
+        }
+        m_lastFlush = Clock::now();
+    }
+
+private:
+    EventLog &m_log;
+    std::vector<Record> m_records;
+    TimePoint m_lastFlush;
+};
+
+
+EventLog& EventLog::instance()
+{
+    static EventLog singleton;
+    return singleton;
+}
+
+
+EventLog::~EventLog()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = false;
+    m_file.close();
+}
+
+
+bool EventLog::open(const std::filesystem::path &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_file.close();
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    BinaryWriter writer(m_file);
+    writer.write(EVENT_LOG_MAGIC);
+    writer.write(EVENT_LOG_VERSION);
+    writer.write(RECORD_SIZE);
+    if (!m_file)
+    {
+        LOG_ERROR("Failed to open event log " << path << ".");
+        m_file.close();
+        return false;
+    }
+
+    LOG_INFO("Writing events to " << path << ".");
+    m_enabled = true;
+    return true;
+}
+
+
+void EventLog::close()
+{
+    if (!enabled())
+    {
+        return;
+    }
+    m_enabled = false;
+    threadBuffer().flush();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_file.close();
+}
+
+
+std::uint64_t EventLog::newGame() noexcept
+{
+    return m_gamesQuantity.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+
+EventLog::ThreadBuffer& EventLog::threadBuffer()
+{
+    thread_local ThreadBuffer buffer(instance());
+    return buffer;
+}
+
+
+void EventLog::append(const Record &record)
+{
+    threadBuffer().push(record);
+}
+
+
+void EventLog::writeBlock(const Record *records, std::size_t quantity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+
+    m_block.resize(sizeof(std::uint32_t) + quantity * RECORD_SIZE);
+    char *cursor = m_block.data();
+    encode(cursor, std::uint32_t(quantity));
+    for (std::size_t i = 0; i < quantity; ++i)
+    {
+        const Record &record = records[i];
+        encode(cursor, record.game);
+        encode(cursor, record.tick);
+        encode(cursor, std::uint8_t(record.type));
+        encode(cursor, record.argument0);
+        encode(cursor, record.argument1);
+        encode(cursor, record.argument2);
+    }
+    m_file.write(m_block.data(), std::streamsize(m_block.size()));
+    m_file.flush();
+}
+
+
+bool readEventLog(
+    const std::filesystem::path &path,
+    const std::function<void(const EventLog::Record&)> &callback)
+{
+    std::ifstream file(path, std::ios::binary);
+    BinaryReader reader(file);
+    std::uint32_t magic{ 0 };
+    std::uint16_t version{ 0 };
+    std::uint16_t recordSize{ 0 };
+    if (!reader.read(magic) ||
+        !reader.read(version) ||
+        !reader.read(recordSize) ||
+        magic != EVENT_LOG_MAGIC ||
+        version != EVENT_LOG_VERSION ||
+        recordSize != EventLog::RECORD_SIZE)
+    {
+        LOG_ERROR("File " << path << " is not an event log.");
+        return false;
+    }
+
+    std::uint32_t quantity{ 0 };
+    while (reader.read(quantity))
+    {
+        for (std::uint32_t i = 0; i < quantity; ++i)
+        {
+            EventLog::Record record;
+            const bool ok =
+                reader.read(record.game) &&
+                reader.read(record.tick) &&
+                reader.read(record.type) &&
+                reader.read(record.argument0) &&
+                reader.read(record.argument1) &&
+                reader.read(record.argument2);
+            if (!ok)
+            {
+                LOG_ERROR("Event log " << path << " is truncated.");
+                return false;
+            }
+            callback(record);
+        }
+    }
+    return true;
+}
@@ -1,16 +1,45 @@
 #include <game/game.h>
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <boost/bind/bind.hpp>
 
+#include <game/atomic_file.h>
+#include <game/benchmark_screen.h>
+#include <game/clock.h>
 #include <game/config.h>
+#include <game/leaderboard.h>
+#include <game/loading_screen.h>
 #include <game/log.h>
+#include <game/profiler.h>
+#include <game/replay.h>
 #include <game/world.h>
 #include <game/resource_loader.h>
 #include <game/serializer.h>
+#include <game/sound_system.h>
+#include <game/spectator_screen.h>
+#include <game/tracer.h>
 #include <game/version/version.h>
 
 
+namespace
+{
+
+/// Каталог, в который сохраняются записи игр.
+const std::filesystem::path REPLAYS_DIR("replays");
+const std::string REPLAY_FILE_EXTENSION = ".replay";
+/// Сохранённая игра, прерванная игроком.
+const std::filesystem::path SAVE_FILE_NAME("save.bin");
+/// Журнал таблицы рекордов.
+const std::filesystem::path LEADERBOARD_FILE_NAME("leaderboard.bin");
+/// Имя, под которым результаты игрока заносятся в таблицу рекордов.
+const std::string PLAYER_NAME = "Игрок";
+
+}
+
+
 Game::Game()
     : m_window(
         ProjectName + " " + ProjectVersion,
@@ -24,8 +53,9 @@ Game::Game()
 
 bool Game::init()
 {
-    // Загрузка текстур и звуков.
-    return ResourceLoader::instance().load();
+    // Текстуры и звуки декодируются в фоне, пока отображается заставка.
+    ResourceLoader::instance().startLoading();
+    return true;
 }
 
 
@@ -47,10 +77,29 @@ void Game::restartClock()
 
 void Game::setup()
 {
-    if (!readConfig())
+    std::optional<unsigned int> legacyHighScore;
+    if (!readConfig(legacyHighScore))
+    {
+        // Файл настроек будет создан со значениями по умолчанию.
+        Config::instance().setDirty(true);
+    }
+    if (Leaderboard::instance().open(LEADERBOARD_FILE_NAME) &&
+        legacyHighScore.has_value())
     {
-        writeConfig();
+        // Рекорд прежних версий переносится в таблицу рекордов один раз:
+        // перезаписанный файл настроек его больше не содержит.
+        LOG_INFO("Moving high score " << legacyHighScore.value() << " into leaderboard.");
+        if (legacyHighScore.value() != 0)
+        {
+            Leaderboard::instance().add(
+                Leaderboard::Board::Players,
+                Config::instance().cranesQuantity(),
+                PLAYER_NAME,
+                legacyHighScore.value());
+        }
+        Config::instance().setDirty(true);
     }
+    m_window.setScale(Config::instance().screenScale());
 
     restartClock();
 }
@@ -58,27 +107,129 @@ void Game::setup()
 
 std::shared_ptr<MenuScreen> Game::makeStartScreen()
 {
-    std::shared_ptr<MenuScreen> menuScreen = std::make_shared<MenuScreen>();
+    std::error_code error;
+    std::shared_ptr<MenuScreen> menuScreen = std::make_shared<MenuScreen>(
+        m_recovery.has_value() || std::filesystem::exists(SAVE_FILE_NAME, error));
     menuScreen->connectClose(
         boost::bind(&Game::onMenuScreenClosed, this, boost::placeholders::_1));
     return menuScreen;
 }
 
 
-std::shared_ptr<World> Game::makeWorldScreen()
+std::shared_ptr<World> Game::makeWorldScreen(bool resume)
 {
     std::shared_ptr<World> worldScreen = std::make_shared<World>();
-    worldScreen->connectClose(boost::bind(&Game::onWorldScreenClosed, this));
-    worldScreen->start(m_initialPosition);
+    worldScreen->connectClose(
+        boost::bind(&Game::onWorldScreenClosed, this, boost::cref(*worldScreen)));
+    worldScreen->connectGameOver(
+        boost::bind(&Game::onWorldGameOver, this, boost::cref(*worldScreen)));
+    worldScreen->setSoundSink(SoundSystem::instance());
+    worldScreen->setPlayerName(PLAYER_NAME);
+    if (!resume || !restoreWorld(*worldScreen))
+    {
+        worldScreen->start(m_initialPosition);
+    }
     return worldScreen;
 }
 
 
+void Game::saveWorld(const World &world)
+{
+    std::ostringstream stream;
+    world.save(stream);
+    if (!stream || !writeFileAtomically(SAVE_FILE_NAME, stream.str()))
+    {
+        LOG_ERROR("Failed to save game into " << SAVE_FILE_NAME << ".");
+        return;
+    }
+    LOG_INFO("Game has been saved into " << SAVE_FILE_NAME << ".");
+}
+
+
+bool Game::restoreWorld(World &world)
+{
+    if (m_recovery.has_value())
+    {
+        std::istringstream stream(m_recovery.value());
+        m_recovery.reset();
+        return world.restore(stream);
+    }
+
+    std::ifstream file(SAVE_FILE_NAME, std::ios::binary);
+    if (!file)
+    {
+        LOG_ERROR("Failed to open saved game " << SAVE_FILE_NAME << ".");
+        return false;
+    }
+    return world.restore(file);
+}
+
+
 void Game::start(const std::optional<unsigned int> &position)
 {
     m_initialPosition = position;
-    m_screen = makeStartScreen();
     m_debug = std::nullopt;
+    whenLoaded([this]() { m_screen = makeStartScreen(); });
+}
+
+
+void Game::startSpectator(std::size_t worldsQuantity)
+{
+    m_debug = std::nullopt;
+    whenLoaded(
+        [this, worldsQuantity]()
+        {
+            std::shared_ptr<SpectatorScreen> spectatorScreen =
+                std::make_shared<SpectatorScreen>(worldsQuantity);
+            spectatorScreen->connectClose(boost::bind(&Game::exit, this));
+            m_window.setFrameSize(SpectatorScreen::frameSize(worldsQuantity));
+            m_screen = spectatorScreen;
+        });
+}
+
+
+std::shared_ptr<const BenchmarkScreen> Game::startBenchmark(const BenchmarkScenario &scenario)
+{
+    m_debug = std::nullopt;
+    std::shared_ptr<BenchmarkScreen> benchmarkScreen =
+        std::make_shared<BenchmarkScreen>(scenario);
+    benchmarkScreen->connectClose(boost::bind(&Game::exit, this));
+    m_window.enableFrameLimit(false);
+    m_screen = benchmarkScreen;
+    return benchmarkScreen;
+}
+
+
+void Game::offerRecovery(std::string snapshot)
+{
+    m_recovery = std::move(snapshot);
+}
+
+
+void Game::whenLoaded(const std::function<void()> &function)
+{
+    if (ResourceLoader::instance().loaded())
+    {
+        function();
+        return;
+    }
+
+    std::shared_ptr<LoadingScreen> loadingScreen = std::make_shared<LoadingScreen>();
+    loadingScreen->connectLoaded(
+        [this, function](bool success) { onLoaded(success, function); });
+    m_screen = loadingScreen;
+}
+
+
+void Game::onLoaded(bool success, const std::function<void()> &function)
+{
+    if (!success)
+    {
+        exit();
+        return;
+    }
+    LOG_INFO("All resources loaded.");
+    function();
 }
 
 
@@ -91,34 +242,48 @@ void Game::onWindowResized(const sf::Vector2u &size)
 
 void Game::onKeyPressed(const sf::Event::KeyEvent &key)
 {
-    m_screen->handleKeyPressed(key.code);
+    // Экран может быть заменён во время обработки клавиши.
+    const std::shared_ptr<Screen> screen = m_screen;
+    screen->handleKeyPressed(key.code);
 }
 
 
 void Game::onKeyReleased(const sf::Event::KeyEvent &key)
 {
-    m_screen->handleKeyReleased(key.code);
+    const std::shared_ptr<Screen> screen = m_screen;
+    screen->handleKeyReleased(key.code);
 }
 
 
 void Game::update()
 {
-    m_screen->update(m_elapsed);
+    PROFILE_ZONE(GameUpdate);
+    TRACE_SCOPE("Game::update");
+    SoundSystem::instance().update();
+    // Экран может быть заменён во время собственного обновления.
+    const std::shared_ptr<Screen> screen = m_screen;
+    screen->update(m_elapsed);
     if (m_debug.has_value())
     {
         m_debug.value().update(m_elapsed);
     }
     m_window.update();
+    if (m_world != nullptr)
+    {
+        m_autosave.update(*m_world, m_elapsed);
+    }
+    m_configWriter.update();
 }
 
 
 void Game::render()
 {
+    TRACE_SCOPE("Game::render");
     m_window.beginDraw();
 
-    sf::RenderWindow &target = m_window.gameWindow();
+    sf::RenderTarget &target = m_window.gameTarget();
     target.draw(*m_screen);
-    m_window.renderClippingMask(target);
+    m_window.drawFrame();
 
     if (m_debug.has_value())
     {
@@ -127,6 +292,7 @@ void Game::render()
     }
 
     m_window.endDraw();
+    PROFILE_FRAME();
 }
 
 
@@ -136,16 +302,18 @@ bool Game::isDone() const noexcept
 }
 
 
-void Game::onMenuScreenClosed(bool startGame)
+void Game::onMenuScreenClosed(MenuScreen::Result result)
 {
-    if (!startGame)
+    if (result == MenuScreen::Result::Exit)
     {
         exit();
         return;
     }
 
-    std::shared_ptr<World> worldScreen = makeWorldScreen();
+    std::shared_ptr<World> worldScreen =
+        makeWorldScreen(result == MenuScreen::Result::Resume);
     m_screen = worldScreen;
+    m_world = worldScreen;
 
 #ifndef NDEBUG
     m_debug = ScreenDebug(worldScreen);
@@ -156,10 +324,41 @@ void Game::onMenuScreenClosed(bool startGame)
 }
 
 
-void Game::onWorldScreenClosed()
+void Game::onWorldScreenClosed(const World &world)
 {
+    if (!world.gameOver())
+    {
+        saveWorld(world);
+    }
+    m_autosave.discard();
+    m_world = nullptr;
     start();
-    writeConfig();
+}
+
+
+void Game::onWorldGameOver(const World &world)
+{
+    // Законченную игру продолжить нельзя.
+    std::error_code error;
+    std::filesystem::remove(SAVE_FILE_NAME, error);
+    m_autosave.discard();
+
+    if (!Config::instance().recordReplays())
+    {
+        return;
+    }
+
+    std::filesystem::create_directories(REPLAYS_DIR, error);
+    if (error)
+    {
+        LOG_ERROR(
+            "Failed to create directory " << REPLAYS_DIR
+            << ": " << error.message() << '.');
+        return;
+    }
+    writeReplay(
+        REPLAYS_DIR / (formatTimeEscaped() + REPLAY_FILE_EXTENSION),
+        world.replay());
 }
 
 
@@ -3,45 +3,7 @@
 #include <cmath>
 
 #include <game/consts.h>
-
-
-namespace
-{
-
-/// Возвращает список точек, составляющих текстуру шахматной доски.
-/// \code
-/// o o o o
-///  o o o
-/// o o o o
-/// \endcode
-std::list<sf::RectangleShape> makeDisabledButton(const sf::Vector2f &position)
-{
-    std::list<sf::RectangleShape> result;
-    for (std::size_t y = 0; y < BUTTON_SIZE.y; ++y)
-    {
-        for (std::size_t x = y % 2; x < BUTTON_SIZE.x; x += 2)
-        {
-            sf::RectangleShape dot(sf::Vector2f(1, 1));
-            dot.setFillColor(TEXT_COLOR);
-            dot.setPosition(position.x + x, position.y + y);
-            result.push_back(dot);
-        }
-    }
-    return result;
-}
-
-
-std::list<sf::RectangleShape> makeEnabledButton(const sf::Vector2f &position)
-{
-    std::list<sf::RectangleShape> result;
-    sf::RectangleShape rectangle(sf::Vector2f(BUTTON_SIZE.x, BUTTON_SIZE.y));
-    rectangle.setFillColor(TEXT_COLOR);
-    rectangle.setPosition(position);
-    result.push_back(rectangle);
-    return result;
-}
-
-}
+#include <game/graphics/menu/decoration.h>
 
 
 Button::Button(const std::u32string &caption)
@@ -56,10 +18,9 @@ Button::Button(const std::u32string &caption)
 
 void Button::draw(sf::RenderTarget &target, sf::RenderStates) const
 {
-    for (const auto &dot : m_background)
-    {
-        target.draw(dot);
-    }
+    sf::RenderStates states;
+    states.transform.translate(m_position);
+    target.draw(*m_background, states);
 
     target.draw(m_text);
 }
@@ -93,9 +54,9 @@ bool Button::enabled() const noexcept
 
 void Button::update()
 {
-    m_background = enabled()
-        ? makeEnabledButton(m_position)
-        : makeDisabledButton(m_position);
+    m_background = &decoration(
+        enabled() ? Decoration::ButtonEnabled : Decoration::ButtonDisabled,
+        TEXT_COLOR);
     m_text.setPosition(sf::Vector2f(
         std::ceil(m_position.x + BUTTON_SIZE.x / 2.0f),
         m_position.y));
@@ -0,0 +1,200 @@
+#include <game/graphics/menu/decoration.h>
+
+#include <map>
+#include <utility>
+
+#include <game/consts.h>
+#include <game/graphics/menu/button.h>
+#include <game/graphics/menu/menu.h>
+
+
+namespace
+{
+
+constexpr std::size_t CHECKBOX_FRAME_SIZE = 11;
+
+
+void addRectangle(
+    sf::VertexArray &vertices,
+    const sf::Vector2f &position,
+    const sf::Vector2f &size,
+    const sf::Color &color)
+{
+    const sf::Vector2f topRight(position.x + size.x, position.y);
+    const sf::Vector2f bottomLeft(position.x, position.y + size.y);
+    const sf::Vector2f bottomRight = position + size;
+    vertices.append(sf::Vertex(position, color));
+    vertices.append(sf::Vertex(topRight, color));
+    vertices.append(sf::Vertex(bottomLeft, color));
+    vertices.append(sf::Vertex(bottomLeft, color));
+    vertices.append(sf::Vertex(topRight, color));
+    vertices.append(sf::Vertex(bottomRight, color));
+}
+
+void addDot(
+    sf::VertexArray &vertices,
+    const sf::Vector2f &position,
+    const sf::Color &color)
+{
+    addRectangle(vertices, position, sf::Vector2f(1, 1), color);
+}
+
+void makeCheckboxFrame(sf::VertexArray &vertices, const sf::Color &color)
+{
+    const float size = CHECKBOX_FRAME_SIZE - 1;
+    for (std::size_t i = 0; i < CHECKBOX_FRAME_SIZE / 2; ++i)
+    {
+        addDot(vertices, sf::Vector2f(i * 2, 0), color);
+        addDot(vertices, sf::Vector2f(size, i * 2), color);
+        addDot(vertices, sf::Vector2f(size - i * 2, size), color);
+        addDot(vertices, sf::Vector2f(0, size - i * 2), color);
+    }
+}
+
+void makeRadioButtonFrame(sf::VertexArray &vertices, const sf::Color &color)
+{
+    const sf::Vector2f dots[] =
+    {
+        { 0, 4 }, { 1, 2 }, { 2, 1 }, { 4, 0 },
+        { 6, 0 }, { 8, 1 }, { 9, 2 }, { 10, 4 },
+        { 0, 6 }, { 1, 8 }, { 2, 9 }, { 4, 10 },
+        { 6, 10 }, { 8, 9 }, { 9, 8 }, { 10, 6 }
+    };
+    for (const sf::Vector2f &dot : dots)
+    {
+        addDot(vertices, dot, color);
+    }
+}
+
+void makeDottedLine(sf::VertexArray &vertices, const sf::Color &color)
+{
+    for (int i = 0; i < 45; ++i)
+    {
+        addDot(vertices, sf::Vector2f(2 * i - 1, 5), color);
+    }
+}
+
+void makeCheckMark(sf::VertexArray &vertices, const sf::Color &color)
+{
+    const sf::Vector2f offset(1, 5);
+    addRectangle(vertices, offset, sf::Vector2f(1, 2), color);
+    addRectangle(vertices, offset + sf::Vector2f(1, 0), sf::Vector2f(1, 3), color);
+    addRectangle(vertices, offset + sf::Vector2f(2, 1), sf::Vector2f(1, 3), color);
+    for (int i = 0; i < 5; ++i)
+    {
+        addRectangle(
+            vertices,
+            offset + sf::Vector2f(3 + i, 1 - i),
+            sf::Vector2f(1, 3),
+            color);
+    }
+}
+
+void makeRadioMark(sf::VertexArray &vertices, const sf::Color &color)
+{
+    const sf::Vector2f offset(4, 2);
+    for (int i = 0; i < 3; ++i)
+    {
+        const float width = 3 + 2 * i;
+        addRectangle(vertices, offset + sf::Vector2f(-i, i), sf::Vector2f(width, 1), color);
+        addRectangle(vertices, offset + sf::Vector2f(-i, 6 - i), sf::Vector2f(width, 1), color);
+    }
+    addRectangle(vertices, offset + sf::Vector2f(-2, 3), sf::Vector2f(7, 1), color);
+}
+
+void makeButtonEnabled(sf::VertexArray &vertices, const sf::Color &color)
+{
+    addRectangle(
+        vertices,
+        sf::Vector2f(),
+        sf::Vector2f(BUTTON_SIZE.x, BUTTON_SIZE.y),
+        color);
+}
+
+/// Шахматная доска.
+/// \code
+/// o o o o
+///  o o o
+/// o o o o
+/// \endcode
+void makeButtonDisabled(sf::VertexArray &vertices, const sf::Color &color)
+{
+    for (std::size_t y = 0; y < BUTTON_SIZE.y; ++y)
+    {
+        for (std::size_t x = y % 2; x < BUTTON_SIZE.x; x += 2)
+        {
+            addDot(vertices, sf::Vector2f(x, y), color);
+        }
+    }
+}
+
+void makeMenuFrame(sf::VertexArray &vertices, const sf::Color &color)
+{
+    const sf::Vector2f size(FRAME_SIZE.x, FRAME_SIZE.y);
+
+    // Фон.
+    addRectangle(vertices, sf::Vector2f(1, 1), size - sf::Vector2f(3, 3), BACKGROUND_COLOR);
+
+    // Линии.
+    addRectangle(vertices, sf::Vector2f(2, 0), sf::Vector2f(size.x - 5, 1), color);
+    addRectangle(vertices, sf::Vector2f(size.x - 2, 2), sf::Vector2f(1, size.y - 4), color);
+    addRectangle(vertices, sf::Vector2f(size.x - 1, 3), sf::Vector2f(1, size.y - 6), color);
+    addRectangle(vertices, sf::Vector2f(2, size.y - 2), sf::Vector2f(size.x - 4, 1), color);
+    addRectangle(vertices, sf::Vector2f(3, size.y - 1), sf::Vector2f(size.x - 6, 1), color);
+    addRectangle(vertices, sf::Vector2f(0, 2), sf::Vector2f(1, size.y - 5), color);
+
+    // Углы.
+    addDot(vertices, sf::Vector2f(1, 1), color);
+    addDot(vertices, sf::Vector2f(size.x - 3, 1), color);
+    addDot(vertices, sf::Vector2f(size.x - 3, size.y - 3), color);
+    addDot(vertices, sf::Vector2f(1, size.y - 3), color);
+}
+
+sf::VertexArray makeDecoration(Decoration type, const sf::Color &color)
+{
+    sf::VertexArray vertices(sf::Triangles);
+    switch (type)
+    {
+    case Decoration::CheckboxFrame:
+        makeCheckboxFrame(vertices, color);
+        break;
+    case Decoration::RadioButtonFrame:
+        makeRadioButtonFrame(vertices, color);
+        break;
+    case Decoration::DottedLine:
+        makeDottedLine(vertices, color);
+        break;
+    case Decoration::CheckMark:
+        makeCheckMark(vertices, color);
+        break;
+    case Decoration::RadioMark:
+        makeRadioMark(vertices, color);
+        break;
+    case Decoration::ButtonEnabled:
+        makeButtonEnabled(vertices, color);
+        break;
+    case Decoration::ButtonDisabled:
+        makeButtonDisabled(vertices, color);
+        break;
+    case Decoration::MenuFrame:
+        makeMenuFrame(vertices, color);
+        break;
+    }
+    return vertices;
+}
+
+}
+
+
+const sf::VertexArray& decoration(Decoration type, const sf::Color &color)
+{
+    static std::map<std::pair<Decoration, sf::Uint32>, sf::VertexArray> cache;
+
+    const std::pair<Decoration, sf::Uint32> key(type, color.toInteger());
+    auto it = cache.find(key);
+    if (it == cache.end())
+    {
+        it = cache.emplace(key, makeDecoration(type, color)).first;
+    }
+    return it->second;
+}
@@ -1,13 +1,29 @@
 #include <game/graphics/menu/menu_high_score.h>
 
+#include <iterator>
+
 
 namespace
 {
 
-constexpr float TEXT_VERTICAL_POSITION = 18;
+constexpr float TEXT_VERTICAL_POSITION = 6;
+constexpr float ROW_HEIGHT = 12;
+/// Отступ строк таблицы от краёв экрана.
+constexpr float ROW_MARGIN = 8;
+/// Наибольшее количество отображаемых символов имени игрока,
+/// чтобы имя не заходило на счёт.
+constexpr std::size_t PLAYER_LENGTH_MAX = 6;
 /// Длительность отображения секретного текста.
 const Duration SECRET_TEXT_VISIBLE_DURATION = std::chrono::seconds(1);
 
+
+std::u32string toText(const std::string &text)
+{
+    std::u32string result;
+    sf::Utf8::toUtf32(text.cbegin(), text.cend(), std::back_inserter(result));
+    return result;
+}
+
 }
 
 
@@ -27,7 +43,7 @@ void MenuHighScore::update(const Duration &elapsed)
     m_secretTextVisibleDuration.value() += elapsed;
     if (m_secretTextVisibleDuration > SECRET_TEXT_VISIBLE_DURATION)
     {
-        setText(m_highScore);
+        setText();
         m_secretTextVisibleDuration = std::nullopt;
     }
 }
@@ -38,30 +54,30 @@ void MenuHighScore::draw(
     sf::RenderStates states) const
 {
     Menu::draw(target, states);
-    target.draw(m_text);
-}
-
-
-unsigned int MenuHighScore::highScore() const noexcept
-{
-    return m_highScore;
+    for (std::size_t i = 0; i < m_rows.size(); ++i)
+    {
+        target.draw(m_rows[i]);
+        target.draw(m_scores[i]);
+    }
 }
 
 
-void MenuHighScore::setHighScore(unsigned int value)
+void MenuHighScore::setEntries(const std::vector<Leaderboard::Entry> &entries)
 {
-    m_highScore = value;
+    m_entries.assign(
+        entries.cbegin(),
+        entries.cbegin() + std::min(entries.size(), HIGH_SCORE_ROWS_QUANTITY));
 
-    if (m_highScore > 9000)
+    if (!m_entries.empty() && m_entries.front().score > 9000)
     {
         setSecretText();
     }
     else
     {
-        setText(m_highScore);
+        setText();
     }
 
-    if (m_highScore > 0)
+    if (!m_entries.empty())
     {
         m_buttonLeft.setCaption(U"Удалить");
         connectLeft([this](){ deleteHighScore(); });
@@ -69,21 +85,63 @@ void MenuHighScore::setHighScore(unsigned int value)
 }
 
 
-void MenuHighScore::setText(unsigned int value)
+bool MenuHighScore::cleared() const noexcept
 {
-    const std::string valueText = std::to_string(value);
-    m_text.setText(
-        std::u32string(valueText.cbegin(), valueText.cend()) + U" очков");
+    return m_cleared;
+}
+
+
+void MenuHighScore::setText()
+{
+    for (std::size_t i = 0; i < m_rows.size(); ++i)
+    {
+        m_rows[i].setText(std::u32string());
+        m_rows[i].setAlign(Text::Align::Left);
+        m_rows[i].setPosition(sf::Vector2f(
+            ROW_MARGIN,
+            TEXT_VERTICAL_POSITION + ROW_HEIGHT * i));
+        m_scores[i].setText(std::u32string());
+    }
+
+    if (m_entries.empty())
+    {
+        setMessage(U"0 очков");
+        return;
+    }
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        const Leaderboard::Entry &entry = m_entries[i];
+        m_rows[i].setText(
+            toText(std::to_string(i + 1)) + U". "
+            + toText(entry.player).substr(0, PLAYER_LENGTH_MAX));
+        m_scores[i].setText(int(entry.score));
+    }
 }
 
 
 void MenuHighScore::setSecretText()
 {
-    m_text.setText(U"Более 9000 очков");
+    for (std::size_t i = 0; i < m_rows.size(); ++i)
+    {
+        m_rows[i].setText(std::u32string());
+        m_scores[i].setText(std::u32string());
+    }
+    setMessage(U"Более 9000 очков");
     m_secretTextVisibleDuration = Duration();
 }
 
 
+void MenuHighScore::setMessage(const std::u32string &text)
+{
+    Text &row = m_rows[1];
+    row.setText(text);
+    row.setAlign(Text::Align::Center);
+    row.setPosition(sf::Vector2f(
+        SCREEN_SIZE.x / 2,
+        TEXT_VERTICAL_POSITION + ROW_HEIGHT));
+}
+
+
 void MenuHighScore::setup()
 {
     makeFrame();
@@ -91,17 +149,25 @@ void MenuHighScore::setup()
     m_buttonRight.setCaption(U"ОК");
     connectRight(boost::bind(&MenuHighScore::close, this));
 
-    m_text.setPosition(sf::Vector2f(SCREEN_SIZE.x / 2, TEXT_VERTICAL_POSITION));
-    m_text.setAlign(Text::Align::Center);
-    m_text.setBold(true);
-    setText(m_highScore);
+    for (std::size_t i = 0; i < m_rows.size(); ++i)
+    {
+        m_rows[i].setBold(true);
+        m_scores[i].setPosition(sf::Vector2f(
+            SCREEN_SIZE.x - ROW_MARGIN,
+            TEXT_VERTICAL_POSITION + ROW_HEIGHT * i));
+        m_scores[i].setAlign(Text::Align::Right);
+        m_scores[i].setBold(true);
+    }
+    setText();
 }
 
 
 void MenuHighScore::deleteHighScore()
 {
-    m_highScore = 0;
-    setText(m_highScore);
+    m_entries.clear();
+    m_cleared = true;
+    m_secretTextVisibleDuration = std::nullopt;
+    setText();
     m_buttonLeft.setCaption(U"");
     m_connectionLeft.disconnect();
 }
@@ -19,6 +19,12 @@ boost::signals2::connection MenuStart::connectOptions(const Slot &slot)
 }
 
 
+void MenuStart::setResumable(bool value)
+{
+    m_buttonLeft.setCaption(value ? U"Продолж." : U"Начать");
+}
+
+
 void MenuStart::setup()
 {
     m_buttonLeft.setCaption(U"Начать");
@@ -1,8 +1,8 @@
 #include <game/graphics/objects/box.h>
 
-#include <random>
 #include <limits>
 
+#include <game/binary_io.h>
 #include <game/resource_loader.h>
 #include "math/math.h"
 
@@ -34,15 +34,6 @@ const TextureSpriteIndices ANIMATION_BLOW
     { 0, 10, false, ANIMATION_INTERVAL }
 };
 
-TextureSpriteIndicesPtr randomRestStyle()
-{
-    static std::mt19937 randomEngine;
-    static std::uniform_int_distribution<std::mt19937::result_type> distributionBoxStyle(
-        0,
-        ANIMATIONS_REST.size() - 1);
-    return &ANIMATIONS_REST.at(distributionBoxStyle(randomEngine));
-}
-
 Duration blowDuration()
 {
     return ANIMATION_BLOW.size() * ANIMATION_INTERVAL;
@@ -51,13 +42,31 @@ Duration blowDuration()
 }
 
 
+std::size_t Box::restStylesQuantity() noexcept
+{
+    return ANIMATIONS_REST.size();
+}
+
+
 Box::Box(
+    std::size_t restStyle,
     const MoveStartedCallback &moveStartedCallback,
     const MoveFinishedCallback &moveFinishedCallback)
-    : m_moveStartedCallback(moveStartedCallback)
+    : m_restStyle(restStyle)
+    , m_moveStartedCallback(moveStartedCallback)
     , m_moveFinishedCallback(moveFinishedCallback)
 {
-    init();
+    init(restStyle);
+}
+
+
+void Box::recycle(std::size_t restStyle)
+{
+    Object::reset();
+    m_restStyle = restStyle;
+    m_blowDuration.reset();
+    setAnimation(AnimationOriented(&ANIMATIONS_REST.at(restStyle)));
+    setTextureRect(mirrorVertical(m_animator->rect()));
 }
 
 
@@ -74,6 +83,12 @@ void Box::update(const Duration &elapsed)
 }
 
 
+std::size_t Box::restStyle() const noexcept
+{
+    return m_restStyle;
+}
+
+
 void Box::move(Direction direction)
 {
     switch (direction)
@@ -122,6 +137,32 @@ bool Box::isBlowed() const noexcept
 }
 
 
+void Box::save(BinaryWriter &writer) const
+{
+    Object::save(writer);
+    writer.write(m_blowDuration.has_value());
+    writer.write(m_blowDuration.value_or(Duration()).count());
+}
+
+
+bool Box::restore(BinaryReader &reader)
+{
+    Object::restore(reader);
+    bool blowing = false;
+    Duration::rep blowDuration = 0;
+    reader.read(blowing);
+    reader.read(blowDuration);
+    if (blowing)
+    {
+        // Анимация взрыва начинается заново, поэтому ящик
+        // исчезает чуть позже, чем исчез бы без сохранения.
+        blow();
+        m_blowDuration = Duration(blowDuration);
+    }
+    return reader.good();
+}
+
+
 void Box::moveStarted()
 {
     Object::moveStarted();
@@ -136,13 +177,15 @@ void Box::moveFinished()
 }
 
 
-void Box::init()
+void Box::init(std::size_t restStyle)
 {
     ResourceLoader &resourceLoader = ResourceLoader::instance();
-    setTexture(*resourceLoader.texture(ResourceLoader::TextureId::Box));
+    resourceLoader.applyTexture(*this, ResourceLoader::TextureId::Box);
 
-    m_animator.reset(new Animator(*getTexture(), TEXTURE_SIZE));
-    setAnimation(AnimationOriented(randomRestStyle()));
+    m_animator.reset(new Animator(
+        resourceLoader.textureSize(ResourceLoader::TextureId::Box),
+        TEXTURE_SIZE));
+    setAnimation(AnimationOriented(&ANIMATIONS_REST.at(restStyle)));
     setTextureRect(mirrorVertical(m_animator->rect()));
     setColor(BACKGROUND_COLOR);
 }
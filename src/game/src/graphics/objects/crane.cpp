@@ -2,6 +2,7 @@
 
 #include <cmath>
 
+#include <game/binary_io.h>
 #include <game/resource_loader.h>
 
 #include "math/math.h"
@@ -31,14 +32,27 @@ Crane::Crane()
 void Crane::init()
 {
     ResourceLoader &resourceLoader = ResourceLoader::instance();
-    setTexture(*resourceLoader.texture(ResourceLoader::TextureId::Crane));
+    resourceLoader.applyTexture(*this, ResourceLoader::TextureId::Crane);
 
-    m_animator.reset(new Animator(*getTexture(), TEXTURE_SIZE));
+    m_animator.reset(new Animator(
+        resourceLoader.textureSize(ResourceLoader::TextureId::Crane),
+        TEXTURE_SIZE));
     setTextureRect(mirrorVertical(m_animator->rect()));
     setColor(BACKGROUND_COLOR);
 }
 
 
+void Crane::recycle()
+{
+    Object::reset();
+    m_left = true;
+    m_readyToReset = false;
+    m_boxId = NULL_ID;
+    m_dropColumn = 0;
+    setTextureRect(mirrorVertical(m_animator->rect()));
+}
+
+
 void Crane::update(const Duration &elapsed)
 {
     Object::update(elapsed);
@@ -129,6 +143,32 @@ bool Crane::readyToReset() const noexcept
 }
 
 
+void Crane::save(BinaryWriter &writer) const
+{
+    Object::save(writer);
+    writer.write(m_left);
+    writer.write(m_readyToReset);
+    writer.write(std::uint64_t(m_boxId));
+    writer.write(std::uint32_t(m_dropColumn));
+}
+
+
+bool Crane::restore(BinaryReader &reader)
+{
+    Object::restore(reader);
+    std::uint64_t boxId = 0;
+    std::uint32_t dropColumn = 0;
+    reader.read(m_left);
+    reader.read(m_readyToReset);
+    reader.read(boxId);
+    reader.read(dropColumn);
+    m_boxId = Id(boxId);
+    m_dropColumn = dropColumn;
+    setAnimation(AnimationOriented(&ANIMATION_HOLDING));
+    return reader.good();
+}
+
+
 void Crane::moveFinished()
 {
     m_readyToReset = true;
@@ -2,6 +2,8 @@
 
 #include <cmath>
 
+#include <game/binary_io.h>
+
 #include "math/math.h"
 
 
@@ -169,14 +171,41 @@ void Object::setAnimation(const AnimationOriented &animation)
 }
 
 
-void Object::setAnimationSequence(const std::vector<AnimationOriented> &ids)
+void Object::setAnimationSequence(std::initializer_list<AnimationOriented> ids)
 {
     m_currentAnimationId = 0;
-    m_animationIds = ids;
+    m_animationIds.assign(ids);
     m_animator->setAnimation(m_animationIds[m_currentAnimationId]);
 }
 
 
+void Object::save(BinaryWriter &writer) const
+{
+    writer.write(getPosition().x);
+    writer.write(getPosition().y);
+    writer.write(m_speed.x);
+    writer.write(m_speed.y);
+    writer.write(m_movementLength.x);
+    writer.write(m_movementLength.y);
+    writer.write(m_moving);
+}
+
+
+bool Object::restore(BinaryReader &reader)
+{
+    sf::Vector2f position;
+    reader.read(position.x);
+    reader.read(position.y);
+    reader.read(m_speed.x);
+    reader.read(m_speed.y);
+    reader.read(m_movementLength.x);
+    reader.read(m_movementLength.y);
+    reader.read(m_moving);
+    setPosition(position);
+    return reader.good();
+}
+
+
 void Object::move(const Duration &elapsed)
 {
     if (!isTolerant(m_speed))
@@ -217,3 +246,16 @@ void Object::moveFinished()
     m_speed = sf::Vector2f();
     m_movementLength = sf::Vector2f();
 }
+
+
+void Object::reset()
+{
+    m_id = m_lastId++;
+    setPosition(sf::Vector2f());
+    m_animator->reset();
+    m_animationIds.clear();
+    m_currentAnimationId = 0;
+    m_speed = sf::Vector2f();
+    m_movementLength = sf::Vector2f();
+    m_moving = false;
+}
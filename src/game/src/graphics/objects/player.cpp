@@ -1,7 +1,6 @@
 #include <game/graphics/objects/player.h>
 
-#include <random>
-
+#include <game/binary_io.h>
 #include <game/log.h>
 #include <game/graphics/objects/object.h>
 #include <game/resource_loader.h>
@@ -30,6 +29,17 @@ const TextureSpriteIndices ANIMATION_JUMP{ { 3, 0 } };
 const TextureSpriteIndices ANIMATION_DYING{ { 4, 0 } };
 const TextureSpriteIndices ANIMATION_DEAD{ { 4, 1 }, { 4, 2 } };
 
+
+/// \return Нормаль направления ((-1, 0), (1, 0), (0, -1), (0, 1)).
+sf::Vector2f directionNormal(Player::Direction direction)
+{
+    return sf::Vector2f(
+        float(bool(direction & Player::Direction::Right)) -
+            float(bool(direction & Player::Direction::Left)),
+        float(bool(direction & Player::Direction::Up)) -
+            float(bool(direction & Player::Direction::Down)));
+}
+
 }
 
 
@@ -49,9 +59,11 @@ Player::Player(const MoveFinishedCallback &callback)
 void Player::init()
 {
     ResourceLoader &resourceLoader = ResourceLoader::instance();
-    setTexture(*resourceLoader.texture(ResourceLoader::TextureId::Player));
+    resourceLoader.applyTexture(*this, ResourceLoader::TextureId::Player);
 
-    m_animator.reset(new Animator(*getTexture(), TEXTURE_SIZE));
+    m_animator.reset(new Animator(
+        resourceLoader.textureSize(ResourceLoader::TextureId::Player),
+        TEXTURE_SIZE));
     setAnimation(AnimationOriented(&ANIMATION_IDLE));
     setTextureRect(mirrorVertical(m_animator->rect()));
     setColor(BACKGROUND_COLOR);
@@ -97,7 +109,7 @@ bool Player::alive() const noexcept
 }
 
 
-void Player::setAlive(bool alive)
+void Player::setAlive(bool alive, bool fallLeft)
 {
     m_alive = alive;
 
@@ -106,19 +118,45 @@ void Player::setAlive(bool alive)
         return;
     }
 
-    std::random_device device;
-    std::mt19937 randomEngine = std::mt19937(device());
-    std::uniform_int_distribution<std::mt19937::result_type> distributionDirection(0, 1);
-    const bool left = distributionDirection(randomEngine) == 0;
-
     m_animator->setAnimationSequence(
         {
             AnimationOriented(&ANIMATION_DYING),
-            AnimationOriented(&ANIMATION_DEAD, left)
+            AnimationOriented(&ANIMATION_DEAD, fallLeft)
         });
 }
 
 
+void Player::save(BinaryWriter &writer) const
+{
+    Object::save(writer);
+    writer.write(m_direction);
+    writer.write(m_lookLeft);
+    writer.write(m_alive);
+    writer.write(m_push);
+}
+
+
+bool Player::restore(BinaryReader &reader)
+{
+    Object::restore(reader);
+    reader.read(m_direction);
+    reader.read(m_lookLeft);
+    reader.read(m_alive);
+    reader.read(m_push);
+    if (isMoving())
+    {
+        setAnimation(AnimationOriented(
+            &animationByDirection(directionNormal(m_direction), m_push),
+            !m_lookLeft));
+    }
+    else
+    {
+        idle();
+    }
+    return reader.good();
+}
+
+
 void Player::moveFinished()
 {
     Object::moveFinished();
@@ -131,15 +169,13 @@ void Player::setDirection(Direction direction, bool push)
     m_speed = sf::Vector2f();
     m_movementLength = sf::Vector2f();
     m_direction = direction;
+    m_push = push;
 
     const bool left = direction & Direction::Left;
     const bool right = direction & Direction::Right;
     const bool up = direction & Direction::Up;
     const bool down = direction & Direction::Down;
-    // Нормаль направления ((-1, 0), (1, 0), (0, -1), (0, 1)).
-    const sf::Vector2f directions(
-        float(right) - float(left),
-        float(up) - float(down));
+    const sf::Vector2f directions = directionNormal(direction);
 
     // Проверка корректности направления.
     if ((left && right) || (up && down))
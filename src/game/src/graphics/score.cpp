@@ -40,6 +40,28 @@ void Score::draw(sf::RenderTarget &target, sf::RenderStates states) const
 }
 
 
+void Score::drawSprites(SpriteSink &sink) const
+{
+    sink.draw(m_frame, ResourceLoader::TextureId::Frame);
+    if (m_hourglass.has_value())
+    {
+        sink.draw(m_hourglass.value(), ResourceLoader::TextureId::Hourglass);
+    }
+    if (m_textVisible)
+    {
+        m_text.drawSprites(sink);
+    }
+}
+
+
+std::size_t Score::drawCalls() const noexcept
+{
+    return 1
+        + (m_hourglass.has_value() ? 1 : 0)
+        + (m_textVisible ? 1 : 0);
+}
+
+
 void Score::update(const Duration &elapsed)
 {
     if (m_blinkDuration.count() == 0)
@@ -68,8 +90,7 @@ void Score::addHourglass(const sf::Vector2f &position)
 {
     ResourceLoader &resourceLoader = ResourceLoader::instance();
     sf::Sprite hourglass;
-    hourglass.setTexture(
-        *resourceLoader.texture(ResourceLoader::TextureId::Hourglass));
+    resourceLoader.applyTexture(hourglass, ResourceLoader::TextureId::Hourglass);
     hourglass.setColor(BACKGROUND_COLOR);
     hourglass.setPosition(position);
     m_hourglass = hourglass;
@@ -92,8 +113,7 @@ void Score::enableBlinking(bool enabled)
 void Score::init()
 {
     ResourceLoader &resourceLoader = ResourceLoader::instance();
-    m_frame.setTexture(
-        *resourceLoader.texture(ResourceLoader::TextureId::Frame));
+    resourceLoader.applyTexture(m_frame, ResourceLoader::TextureId::Frame);
     m_frame.setColor(BACKGROUND_COLOR);
 
     m_text.setColor(TEXT_COLOR);
@@ -0,0 +1,273 @@
+#include <game/graphics/software_renderer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <game/consts.h>
+#include <game/world.h>
+
+
+namespace
+{
+
+constexpr std::size_t CHANNELS = 4;
+
+constexpr std::uint8_t ALPHA_TRANSPARENT = 0;
+constexpr std::uint8_t ALPHA_OPAQUE = 255;
+
+/// Умножение компонент цвета с округлением, как при выводе шейдером SFML.
+std::uint8_t modulate(std::uint8_t a, std::uint8_t b)
+{
+    return (unsigned(a) * unsigned(b) + 127) / 255;
+}
+
+/// Смешивание по формуле sf::BlendAlpha для одной компоненты цвета.
+std::uint8_t blend(std::uint8_t source, std::uint8_t destination, std::uint8_t alpha)
+{
+    return (unsigned(source) * alpha + unsigned(destination) * (255 - alpha) + 127) / 255;
+}
+
+/// Яркость пикселя по рекомендации ITU-R BT.601.
+std::uint8_t luminance(const std::uint8_t *pixel)
+{
+    return (pixel[0] * 299u + pixel[1] * 587u + pixel[2] * 114u + 500u) / 1000u;
+}
+
+}
+
+
+std::size_t SoftwareRenderer::frameSize(PixelFormat format) noexcept
+{
+    const std::size_t channels = format == PixelFormat::Rgba ? CHANNELS : 1;
+    return std::size_t(SCREEN_SIZE.x) * SCREEN_SIZE.y * channels;
+}
+
+
+SoftwareRenderer::SoftwareRenderer()
+{
+    const ResourceLoader &resourceLoader = ResourceLoader::instance();
+    for (std::uint8_t i = 0; i <= ResourceLoader::TextureId::Hourglass; ++i)
+    {
+        const ResourceLoader::TextureId id = ResourceLoader::TextureId(i);
+        const ImagePtr image = resourceLoader.image(id);
+        if (image != nullptr)
+        {
+            m_images[id] = image;
+        }
+    }
+
+    m_clearRow.resize(SCREEN_SIZE.x * CHANNELS);
+    for (std::size_t x = 0; x < SCREEN_SIZE.x; ++x)
+    {
+        std::uint8_t *pixel = m_clearRow.data() + x * CHANNELS;
+        pixel[0] = BACKGROUND_COLOR.r;
+        pixel[1] = BACKGROUND_COLOR.g;
+        pixel[2] = BACKGROUND_COLOR.b;
+        pixel[3] = BACKGROUND_COLOR.a;
+    }
+    m_frameRgba.resize(frameSize(PixelFormat::Rgba));
+}
+
+
+void SoftwareRenderer::render(
+    const World &world,
+    std::uint8_t *buffer,
+    PixelFormat format)
+{
+    m_frame = format == PixelFormat::Rgba ? buffer : m_frameRgba.data();
+
+    // Очистка кадра, как в Window::beginDraw().
+    for (std::size_t y = 0; y < SCREEN_SIZE.y; ++y)
+    {
+        std::memcpy(
+            m_frame + y * m_clearRow.size(),
+            m_clearRow.data(),
+            m_clearRow.size());
+    }
+
+    world.drawSprites(*this);
+
+    if (format == PixelFormat::Gray)
+    {
+        const std::size_t pixels = frameSize(PixelFormat::Gray);
+        for (std::size_t i = 0; i < pixels; ++i)
+        {
+            buffer[i] = luminance(m_frame + i * CHANNELS);
+        }
+    }
+    m_frame = nullptr;
+}
+
+
+void SoftwareRenderer::drawQuad(
+    ResourceLoader::TextureId texture,
+    const sf::IntRect &rect,
+    const sf::Vector2f &position,
+    const sf::Color &color)
+{
+    if (m_frame == nullptr)
+    {
+        return;
+    }
+
+    const bool mirroredX = rect.width < 0;
+    const bool mirroredY = rect.height < 0;
+    const Sheet *sheet = this->sheet(texture, color, mirroredX);
+    if (sheet == nullptr)
+    {
+        return;
+    }
+
+    // Пиксель покрывается фрагментом, если центр пикселя попадает
+    // в фрагмент. Первому покрытому пикселю соответствует первый
+    // тексель фрагмента, следующим - следующие.
+    const int x = int(std::ceil(position.x - 0.5f));
+    const int y = int(std::ceil(position.y - 0.5f));
+    const int width = std::abs(rect.width);
+    const int height = std::abs(rect.height);
+
+    // В отражённом листе столбец left - 1 - k исходного
+    // становится столбцом size.x - left + k.
+    const int column = mirroredX ? int(sheet->size.x) - rect.left : rect.left;
+    for (int k = 0; k < height; ++k)
+    {
+        const int row = mirroredY ? rect.top - 1 - k : rect.top + k;
+        if (y + k < 0 || y + k >= int(SCREEN_SIZE.y) ||
+            row < 0 || row >= int(sheet->size.y))
+        {
+            continue;
+        }
+        blitRow(*sheet, row, column, width, x, y + k);
+    }
+}
+
+
+const SoftwareRenderer::Sheet* SoftwareRenderer::sheet(
+    ResourceLoader::TextureId texture,
+    const sf::Color &color,
+    bool mirrored)
+{
+    const SheetKey key(texture, color.toInteger(), mirrored);
+    const auto it = m_sheets.find(key);
+    if (it != m_sheets.cend())
+    {
+        return &it->second;
+    }
+
+    const auto imageIt = m_images.find(texture);
+    if (imageIt == m_images.cend())
+    {
+        return nullptr;
+    }
+
+    // Лист спрайтов декодируется один раз для каждого сочетания цвета
+    // и отражения: пиксели заранее умножаются на цвет, а строки делятся
+    // на участки непрозрачных и полупрозрачных пикселей.
+    const sf::Image &image = *imageIt->second;
+    Sheet sheet;
+    sheet.size = image.getSize();
+    sheet.pixels.resize(std::size_t(sheet.size.x) * sheet.size.y * CHANNELS);
+    sheet.rowRuns.reserve(sheet.size.y + 1);
+    const std::uint8_t *source = image.getPixelsPtr();
+    for (unsigned int y = 0; y < sheet.size.y; ++y)
+    {
+        const std::size_t rowBegin = sheet.runs.size();
+        sheet.rowRuns.push_back(rowBegin);
+        for (unsigned int x = 0; x < sheet.size.x; ++x)
+        {
+            const unsigned int sourceX = mirrored ? sheet.size.x - 1 - x : x;
+            const std::uint8_t *texel =
+                source + (std::size_t(y) * sheet.size.x + sourceX) * CHANNELS;
+            std::uint8_t *pixel =
+                sheet.pixels.data() + (std::size_t(y) * sheet.size.x + x) * CHANNELS;
+            pixel[0] = modulate(texel[0], color.r);
+            pixel[1] = modulate(texel[1], color.g);
+            pixel[2] = modulate(texel[2], color.b);
+            pixel[3] = modulate(texel[3], color.a);
+
+            if (pixel[3] == ALPHA_TRANSPARENT)
+            {
+                continue;
+            }
+            const bool opaque = pixel[3] == ALPHA_OPAQUE;
+            if (sheet.runs.size() > rowBegin &&
+                sheet.runs.back().end == x &&
+                sheet.runs.back().opaque == opaque)
+            {
+                ++sheet.runs.back().end;
+            }
+            else
+            {
+                sheet.runs.push_back(Run{
+                    std::uint16_t(x),
+                    std::uint16_t(x + 1),
+                    opaque });
+            }
+        }
+    }
+    sheet.rowRuns.push_back(sheet.runs.size());
+
+    return &m_sheets.emplace(key, std::move(sheet)).first->second;
+}
+
+
+void SoftwareRenderer::blitRow(
+    const Sheet &sheet,
+    unsigned int sheetRow,
+    int sheetColumn,
+    int width,
+    int x,
+    int y)
+{
+    // Отсечение по границам кадра и листа спрайтов.
+    const int begin = std::max({ 0, -x, -sheetColumn });
+    const int end = std::min({
+        width,
+        int(SCREEN_SIZE.x) - x,
+        int(sheet.size.x) - sheetColumn });
+    if (begin >= end)
+    {
+        return;
+    }
+    const int sourceBegin = sheetColumn + begin;
+    const int sourceEnd = sheetColumn + end;
+
+    const std::uint8_t *source =
+        sheet.pixels.data() + std::size_t(sheetRow) * sheet.size.x * CHANNELS;
+    std::uint8_t *destination =
+        m_frame + std::size_t(y) * SCREEN_SIZE.x * CHANNELS;
+    const int offset = x - sheetColumn;
+
+    for (std::size_t i = sheet.rowRuns[sheetRow]; i < sheet.rowRuns[sheetRow + 1]; ++i)
+    {
+        const Run &run = sheet.runs[i];
+        const int runBegin = std::max(int(run.begin), sourceBegin);
+        const int runEnd = std::min(int(run.end), sourceEnd);
+        if (runBegin >= runEnd)
+        {
+            continue;
+        }
+
+        if (run.opaque)
+        {
+            // Непрозрачные пиксели копируются целой строкой.
+            std::memcpy(
+                destination + (runBegin + offset) * CHANNELS,
+                source + runBegin * CHANNELS,
+                (runEnd - runBegin) * CHANNELS);
+            continue;
+        }
+
+        for (int column = runBegin; column < runEnd; ++column)
+        {
+            const std::uint8_t *texel = source + column * CHANNELS;
+            std::uint8_t *pixel = destination + (column + offset) * CHANNELS;
+            const std::uint8_t alpha = texel[3];
+            pixel[0] = blend(texel[0], pixel[0], alpha);
+            pixel[1] = blend(texel[1], pixel[1], alpha);
+            pixel[2] = blend(texel[2], pixel[2], alpha);
+            pixel[3] = blend(ALPHA_OPAQUE, pixel[3], alpha);
+        }
+    }
+}
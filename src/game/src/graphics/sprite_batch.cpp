@@ -0,0 +1,126 @@
+#include <game/graphics/sprite_batch.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <game/log.h>
+#include <game/resource_loader.h>
+
+
+namespace
+{
+
+constexpr std::size_t VERTICES_PER_QUAD = 6;
+
+}
+
+
+SpriteBatch::SpriteBatch()
+    : m_vertices(sf::Triangles)
+{
+    buildAtlas();
+}
+
+
+void SpriteBatch::clear()
+{
+    m_vertices.clear();
+}
+
+
+void SpriteBatch::setOffset(const sf::Vector2f &offset)
+{
+    m_offset = offset;
+}
+
+
+std::size_t SpriteBatch::quadsQuantity() const noexcept
+{
+    return m_vertices.getVertexCount() / VERTICES_PER_QUAD;
+}
+
+
+void SpriteBatch::drawQuad(
+    ResourceLoader::TextureId texture,
+    const sf::IntRect &rect,
+    const sf::Vector2f &position,
+    const sf::Color &color)
+{
+    const auto it = m_atlasPositions.find(texture);
+    if (it == m_atlasPositions.cend())
+    {
+        return;
+    }
+
+    // Отрицательные ширина и высота фрагмента меняют местами
+    // текстурные координаты противоположных сторон, что и даёт отражение.
+    const sf::Vector2f &atlasPosition = it->second;
+    const float left = atlasPosition.x + rect.left;
+    const float top = atlasPosition.y + rect.top;
+    const float right = left + rect.width;
+    const float bottom = top + rect.height;
+
+    const sf::Vector2f topLeft = position + m_offset;
+    const sf::Vector2f bottomRight =
+        topLeft + sf::Vector2f(std::abs(rect.width), std::abs(rect.height));
+
+    const sf::Vertex vertices[VERTICES_PER_QUAD] =
+    {
+        sf::Vertex(topLeft, color, sf::Vector2f(left, top)),
+        sf::Vertex(sf::Vector2f(bottomRight.x, topLeft.y), color, sf::Vector2f(right, top)),
+        sf::Vertex(sf::Vector2f(topLeft.x, bottomRight.y), color, sf::Vector2f(left, bottom)),
+        sf::Vertex(sf::Vector2f(topLeft.x, bottomRight.y), color, sf::Vector2f(left, bottom)),
+        sf::Vertex(sf::Vector2f(bottomRight.x, topLeft.y), color, sf::Vector2f(right, top)),
+        sf::Vertex(bottomRight, color, sf::Vector2f(right, bottom))
+    };
+    for (const sf::Vertex &vertex : vertices)
+    {
+        m_vertices.append(vertex);
+    }
+}
+
+
+void SpriteBatch::draw(sf::RenderTarget &target, sf::RenderStates states) const
+{
+    states.texture = &m_atlas;
+    target.draw(m_vertices, states);
+}
+
+
+void SpriteBatch::buildAtlas()
+{
+    // Текстуры невелики, поэтому располагаются в атласе друг под другом.
+    const ResourceLoader &resourceLoader = ResourceLoader::instance();
+    sf::Vector2u atlasSize;
+    for (std::uint8_t i = 0; i <= ResourceLoader::TextureId::Hourglass; ++i)
+    {
+        const ImagePtr image = resourceLoader.image(ResourceLoader::TextureId(i));
+        if (image != nullptr)
+        {
+            atlasSize.x = std::max(atlasSize.x, image->getSize().x);
+            atlasSize.y += image->getSize().y;
+        }
+    }
+
+    sf::Image atlas;
+    atlas.create(atlasSize.x, atlasSize.y, sf::Color::Transparent);
+    unsigned int top = 0;
+    for (std::uint8_t i = 0; i <= ResourceLoader::TextureId::Hourglass; ++i)
+    {
+        const ResourceLoader::TextureId id = ResourceLoader::TextureId(i);
+        const ImagePtr image = resourceLoader.image(id);
+        if (image == nullptr)
+        {
+            continue;
+        }
+        atlas.copy(*image, 0, top);
+        m_atlasPositions[id] = sf::Vector2f(0, top);
+        top += image->getSize().y;
+    }
+
+    if (!m_atlas.loadFromImage(atlas))
+    {
+        LOG_ERROR("Unable to create sprite atlas " << atlasSize.x << 'x' << atlasSize.y << '.');
+    }
+    m_atlas.setSmooth(false);
+}
@@ -0,0 +1,32 @@
+#include <game/graphics/sprite_sink.h>
+
+#include "math/math.h"
+
+
+void SpriteSink::draw(
+    const sf::Sprite &sprite,
+    ResourceLoader::TextureId texture,
+    const sf::Transform &transform)
+{
+    const sf::Transform combined = transform * sprite.getTransform();
+    const sf::FloatRect bounds = combined.transformRect(sprite.getLocalBounds());
+
+    // Отражения, заданные преобразованием, переносятся на фрагмент текстуры.
+    // Матрица 4x4 хранится по столбцам: [0] - масштаб по X, [5] - по Y.
+    sf::IntRect rect = sprite.getTextureRect();
+    const float *matrix = combined.getMatrix();
+    if (matrix[0] < 0)
+    {
+        rect = sf::IntRect(rect.left + rect.width, rect.top, -rect.width, rect.height);
+    }
+    if (matrix[5] < 0)
+    {
+        rect = mirrorVertical(rect);
+    }
+
+    drawQuad(
+        texture,
+        rect,
+        sf::Vector2f(bounds.left, bounds.top),
+        sprite.getColor());
+}
@@ -1,6 +1,8 @@
 #include <game/graphics/text.h>
 
+#include <algorithm>
 #include <array>
+#include <charconv>
 
 #include <game/resource_loader.h>
 
@@ -8,21 +10,29 @@
 namespace
 {
 
-/// Размерность текстуры в количестве спрайтов по горизонтали и вертикали.
-const sf::Vector2u TEXTURE_SIZE(33, 7);
-
-const sf::Vector2u GRID_CELL_SIZE(7, 12);
+/// Размер ячейки сетки, по которой расположены символы в текстуре шрифта.
+constexpr unsigned int GRID_CELL_SIZE_X = 7;
+constexpr unsigned int GRID_CELL_SIZE_Y = 12;
 
 /// Горизонтальный интервал между символами.
 constexpr unsigned int CHARACTER_GAP = 1;
 
+constexpr std::size_t VERTICES_PER_GLYPH = 6;
+
+/// Наибольшая длина записи целого числа со знаком.
+constexpr std::size_t NUMBER_LENGTH_MAX = 12;
+
+/// Количество букв кириллицы.
+constexpr std::size_t CYRILLIC_LETTERS_QUANTITY = 33;
+
 /// Ширины символов кириллицы в алфавитном порядке.
 /// Каждый символ описан 4 значениям:
 /// * широта обычного заглавного символа,
 /// * широта обычного строчного символа,
 /// * широта жирного заглавного символа,
 /// * широта жирного строчного символа.
-const std::array<std::array<std::uint8_t, 4>, 33> CYRILLIC_CHARACTERS_WIDTHS =
+constexpr std::array<std::array<std::uint8_t, 4>, CYRILLIC_LETTERS_QUANTITY>
+CYRILLIC_CHARACTERS_WIDTHS =
 {{
     { 5, 5, 5, 5 }, // 00, а
     { 5, 5, 5, 5 }, // 01, б
@@ -59,102 +69,150 @@ const std::array<std::array<std::uint8_t, 4>, 33> CYRILLIC_CHARACTERS_WIDTHS =
     { 5, 5, 5, 5 }  // 32, я
 }};
 
-struct CharacterInfo
+/// Ширина символов цифр.
+constexpr std::uint8_t DIGITS_CHARACTERS_WIDTH = 5;
+
+/// Специальные символы: код, столбец и строка в сетке текстуры, ширина.
+struct MiscCharacter
 {
-    sf::Vector2u location;
-    std::uint8_t width{ 0 };
+    char32_t code;
+    std::uint8_t column;
+    std::uint8_t row;
+    std::uint8_t width;
 };
+constexpr std::array<MiscCharacter, 3> MISC_CHARACTERS =
+{{
+    { U'?', 0, 0, 5 },
+    { U'.', 1, 0, 3 },
+    { U' ', 2, 0, 3 }
+}};
 
-/// Ширины специальных символов.
-const std::map<char32_t, CharacterInfo> MISC_CHARACTERS_WIDTHS =
+/// Фрагмент текстуры шрифта, изображающий символ.
+struct Glyph
 {
-    { '?', CharacterInfo{ sf::Vector2u(0, 0), 5 } },
-    { '.', CharacterInfo{ sf::Vector2u(1, 0), 3 } },
-    { ' ', CharacterInfo{ sf::Vector2u(2, 0), 3 } }
+    std::uint8_t left{ 0 };
+    std::uint8_t top{ 0 };
+    /// Нулевая ширина у неподдерживаемых символов.
+    std::uint8_t width{ 0 };
 };
 
-/// Ширина символов цифр в порядке возрастания.
-constexpr unsigned char DIGITS_CHARACTERS_WIDTH = 5;
-
-unsigned int letterNumber(
-    char32_t c,
-    char32_t letterA,
-    char32_t letterE,
-    char32_t letterYo)
+constexpr std::size_t DIGITS_OFFSET = MISC_CHARACTERS.size();
+constexpr std::size_t UPPER_CASE_OFFSET = DIGITS_OFFSET + 10;
+constexpr std::size_t LOWER_CASE_OFFSET = UPPER_CASE_OFFSET + CYRILLIC_LETTERS_QUANTITY;
+/// Количество поддерживаемых символов.
+constexpr std::size_t GLYPHS_QUANTITY = LOWER_CASE_OFFSET + CYRILLIC_LETTERS_QUANTITY;
+constexpr std::size_t NO_GLYPH = GLYPHS_QUANTITY;
+
+/*!
+ * Возвращает порядковый номер буквы кириллицы в алфавите.
+ * \param[in] c Буква.
+ * \param[in] letterA Буква "А" того же регистра.
+ * \param[in] letterE Буква "Е" того же регистра.
+ */
+constexpr std::size_t letterNumber(char32_t c, char32_t letterA, char32_t letterE)
 {
-    if (c == letterYo)
-    {
-        return 6;
-    }
-
     return c - letterA + (c <= letterE ? 0 : 1);
 }
 
-unsigned int upperCaseLetterNumber(char32_t c)
-{
-    return letterNumber(c, u'А', u'Е', u'Ё');
-}
-
-unsigned int lowerCaseLetterNumber(char32_t c)
-{
-    return letterNumber(c, u'а', u'е', u'ё');
-}
-
-
-sf::IntRect spriteRectByCharacter(char32_t c, bool bold)
+/*!
+ * Возвращает индекс символа в таблице GLYPHS.
+ * \return NO_GLYPH, если символ не поддерживается.
+ */
+constexpr std::size_t glyphIndex(char32_t c)
 {
-    const unsigned int boldOffset = bold ? 1 : 0;
-
-    sf::IntRect rect;
-    if (c >= u'0' && c <= u'9')
+    if (c >= U'0' && c <= U'9')
+    {
+        return DIGITS_OFFSET + (c - U'0');
+    }
+    if (c >= U'А' && c <= U'Я')
+    {
+        return UPPER_CASE_OFFSET + letterNumber(c, U'А', U'Е');
+    }
+    if (c >= U'а' && c <= U'я')
     {
-        rect = sf::IntRect(
-            c - u'0',
-            2 + boldOffset,
-            DIGITS_CHARACTERS_WIDTH,
-            GRID_CELL_SIZE.y);
+        return LOWER_CASE_OFFSET + letterNumber(c, U'а', U'е');
     }
-    else if ((c >= u'А' && c <= u'Я') || c == U'Ё')
+    if (c == U'Ё')
     {
-        const unsigned int letterNumber = upperCaseLetterNumber(c);
-        rect = sf::IntRect(
-            letterNumber,
-            4 + 2 * boldOffset,
-            CYRILLIC_CHARACTERS_WIDTHS[letterNumber][2 * boldOffset],
-            GRID_CELL_SIZE.y);
+        return UPPER_CASE_OFFSET + 6;
     }
-    else if ((c >= u'а' && c <= u'я') || c == U'ё')
+    if (c == U'ё')
     {
-        const unsigned int letterNumber = lowerCaseLetterNumber(c);
-        rect = sf::IntRect(
-            letterNumber,
-            5 + 2 * boldOffset,
-            CYRILLIC_CHARACTERS_WIDTHS[letterNumber][1 + 2 * boldOffset],
-            GRID_CELL_SIZE.y);
+        return LOWER_CASE_OFFSET + 6;
     }
-    else
+    for (std::size_t i = 0; i < MISC_CHARACTERS.size(); ++i)
     {
-        const auto it = MISC_CHARACTERS_WIDTHS.find(c);
-        if (it != MISC_CHARACTERS_WIDTHS.cend())
+        if (MISC_CHARACTERS[i].code == c)
         {
-            rect = sf::IntRect(
-                it->second.location.x,
-                it->second.location.y + boldOffset,
-                it->second.width,
-                GRID_CELL_SIZE.y);
+            return i;
         }
     }
+    return NO_GLYPH;
+}
 
-    rect.left *= GRID_CELL_SIZE.x;
-    rect.top *= GRID_CELL_SIZE.y;
+constexpr Glyph makeGlyph(std::size_t column, std::size_t row, std::uint8_t width)
+{
+    return Glyph{
+        std::uint8_t(column * GRID_CELL_SIZE_X),
+        std::uint8_t(row * GRID_CELL_SIZE_Y),
+        width };
+}
 
-    return rect;
+/*!
+ * Строит таблицу символов: сначала обычное начертание всех символов,
+ * затем жирное.
+ */
+constexpr std::array<Glyph, 2 * GLYPHS_QUANTITY> makeGlyphs()
+{
+    std::array<Glyph, 2 * GLYPHS_QUANTITY> glyphs{};
+    for (std::size_t bold = 0; bold < 2; ++bold)
+    {
+        Glyph *table = glyphs.data() + bold * GLYPHS_QUANTITY;
+        for (std::size_t i = 0; i < MISC_CHARACTERS.size(); ++i)
+        {
+            const MiscCharacter &c = MISC_CHARACTERS[i];
+            table[i] = makeGlyph(c.column, c.row + bold, c.width);
+        }
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            table[DIGITS_OFFSET + i] = makeGlyph(i, 2 + bold, DIGITS_CHARACTERS_WIDTH);
+        }
+        for (std::size_t i = 0; i < CYRILLIC_LETTERS_QUANTITY; ++i)
+        {
+            table[UPPER_CASE_OFFSET + i] = makeGlyph(
+                i,
+                4 + 2 * bold,
+                CYRILLIC_CHARACTERS_WIDTHS[i][2 * bold]);
+            table[LOWER_CASE_OFFSET + i] = makeGlyph(
+                i,
+                5 + 2 * bold,
+                CYRILLIC_CHARACTERS_WIDTHS[i][1 + 2 * bold]);
+        }
+    }
+    return glyphs;
+}
+
+constexpr std::array<Glyph, 2 * GLYPHS_QUANTITY> GLYPHS = makeGlyphs();
+
+static_assert(GLYPHS[glyphIndex(U'Д')].width == 7);
+static_assert(GLYPHS[GLYPHS_QUANTITY + glyphIndex(U'ш')].width == 6);
+static_assert(GLYPHS[glyphIndex(U'Ё')].left == 6 * GRID_CELL_SIZE_X);
+
+Glyph glyph(char32_t c, bool bold)
+{
+    const std::size_t index = glyphIndex(c);
+    if (index == NO_GLYPH)
+    {
+        return Glyph();
+    }
+    return GLYPHS[index + (bold ? GLYPHS_QUANTITY : 0)];
 }
 
 }
 
 
 Text::Text(const std::u32string &text)
+    : m_vertices(sf::Triangles)
 {
     setText(text);
 }
@@ -162,11 +220,32 @@ Text::Text(const std::u32string &text)
 
 void Text::draw(sf::RenderTarget &target, sf::RenderStates states) const
 {
-    sf::Transform transform = states.transform;
-    transform.translate(m_position);
-    for (const sf::Sprite &sprite : m_characters)
+    if (m_vertices.getVertexCount() == 0)
+    {
+        return;
+    }
+    states.transform.translate(m_position);
+    states.texture = m_texture.get();
+    target.draw(m_vertices, states);
+}
+
+
+void Text::drawSprites(SpriteSink &sink) const
+{
+    for (std::size_t i = 0; i < m_vertices.getVertexCount(); i += VERTICES_PER_GLYPH)
     {
-        target.draw(sprite, transform);
+        const sf::Vertex &topLeft = m_vertices[i];
+        const sf::Vertex &bottomRight = m_vertices[i + VERTICES_PER_GLYPH - 1];
+        const sf::Vector2f size = bottomRight.texCoords - topLeft.texCoords;
+        sink.drawQuad(
+            ResourceLoader::TextureId::Font,
+            sf::IntRect(
+                int(topLeft.texCoords.x),
+                int(topLeft.texCoords.y),
+                int(size.x),
+                int(size.y)),
+            m_position + topLeft.position,
+            topLeft.color);
     }
 }
 
@@ -179,13 +258,23 @@ const sf::Vector2f &Text::position() const
 
 void Text::setPosition(const sf::Vector2f &position)
 {
+    // Положение применяется при отрисовке и не требует перестроения.
     m_position = position;
-    update();
+}
+
+
+bool Text::bold() const noexcept
+{
+    return m_bold;
 }
 
 
 void Text::setBold(bool bold)
 {
+    if (m_bold == bold)
+    {
+        return;
+    }
     m_bold = bold;
     update();
 }
@@ -199,6 +288,10 @@ const std::u32string &Text::text() const noexcept
 
 void Text::setText(const std::u32string &text)
 {
+    if (m_text == text)
+    {
+        return;
+    }
     m_text = text;
     update();
 }
@@ -206,8 +299,19 @@ void Text::setText(const std::u32string &text)
 
 void Text::setText(int number)
 {
-    const std::string valueText = std::to_string(number);
-    setText(std::u32string(valueText.cbegin(), valueText.cend()));
+    // Число записывается без временных строк, чтобы текст,
+    // уже вмещавший число такой же длины, не выделял память.
+    std::array<char, NUMBER_LENGTH_MAX> digits{};
+    char *end = std::to_chars(digits.data(), digits.data() + digits.size(), number).ptr;
+    std::array<char32_t, NUMBER_LENGTH_MAX> text{};
+    const std::size_t length = std::size_t(end - digits.data());
+    std::copy(digits.data(), end, text.begin());
+    if (m_text.compare(0, std::u32string::npos, text.data(), length) == 0)
+    {
+        return;
+    }
+    m_text.assign(text.data(), length);
+    update();
 }
 
 
@@ -219,6 +323,10 @@ Text::Align Text::align() const noexcept
 
 void Text::setAlign(Align align)
 {
+    if (m_align == align)
+    {
+        return;
+    }
     m_align = align;
     update();
 }
@@ -226,33 +334,51 @@ void Text::setAlign(Align align)
 
 void Text::setColor(const sf::Color &color)
 {
+    if (m_color == color)
+    {
+        return;
+    }
     m_color = color;
-    update();
+    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+    {
+        m_vertices[i].color = m_color;
+    }
 }
 
 
 void Text::update()
 {
-    m_characters.clear();
+    m_vertices.clear();
     if (m_text.empty())
     {
         return;
     }
 
-    ResourceLoader &resourceLoader = ResourceLoader::instance();
-    const sf::Texture &texture =
-        *resourceLoader.texture(ResourceLoader::TextureId::Font);
+    if (m_texture == nullptr)
+    {
+        m_texture = ResourceLoader::instance().texture(ResourceLoader::TextureId::Font);
+    }
 
-    int offset = 0;
+    float offset = 0;
     for (const char32_t c : m_text)
     {
-        sf::Sprite sprite;
-        sprite.setTexture(texture);
-        sprite.setTextureRect(spriteRectByCharacter(c, m_bold));
-        sprite.setColor(m_color);
-        sprite.setPosition(offset, 0);
-        m_characters.push_back(sprite);
-        offset += sprite.getTextureRect().width + CHARACTER_GAP;
+        const Glyph glyph = ::glyph(c, m_bold);
+        if (glyph.width != 0)
+        {
+            const float left = glyph.left;
+            const float top = glyph.top;
+            const float right = left + glyph.width;
+            const float bottom = top + GRID_CELL_SIZE_Y;
+            const float width = glyph.width;
+            const float height = GRID_CELL_SIZE_Y;
+            m_vertices.append(sf::Vertex(sf::Vector2f(offset, 0), m_color, sf::Vector2f(left, top)));
+            m_vertices.append(sf::Vertex(sf::Vector2f(offset + width, 0), m_color, sf::Vector2f(right, top)));
+            m_vertices.append(sf::Vertex(sf::Vector2f(offset, height), m_color, sf::Vector2f(left, bottom)));
+            m_vertices.append(sf::Vertex(sf::Vector2f(offset, height), m_color, sf::Vector2f(left, bottom)));
+            m_vertices.append(sf::Vertex(sf::Vector2f(offset + width, 0), m_color, sf::Vector2f(right, top)));
+            m_vertices.append(sf::Vertex(sf::Vector2f(offset + width, height), m_color, sf::Vector2f(right, bottom)));
+        }
+        offset += glyph.width + CHARACTER_GAP;
     }
 
     // Смещение для выравнивания.
@@ -262,10 +388,10 @@ void Text::update()
     }
     if (m_align == Align::Center)
     {
-        offset /= 2;
+        offset = float(int(offset) / 2);
     }
-    for (sf::Sprite &sprite : m_characters)
+    for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
     {
-        sprite.move(-offset, 0);
+        m_vertices[i].position.x -= offset;
     }
 }
@@ -0,0 +1,444 @@
+#include <game/leaderboard.h>
+
+#include <algorithm>
+#include <ctime>
+
+#include <game/binary_io.h>
+#include <game/log.h>
+
+
+namespace
+{
+
+/// Сигнатура журнала рекордов.
+constexpr std::uint32_t LEADERBOARD_MAGIC = 0x424C4B53; // "SKLB"
+/// Версия формата журнала рекордов.
+constexpr std::uint16_t LEADERBOARD_VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 8;
+/// Журнал сжимается, когда записей в нём больше, чем хранимых в памяти
+/// результатов, в указанное количество раз плюс COMPACTION_MINIMUM.
+constexpr std::size_t COMPACTION_RATIO = 4;
+constexpr std::size_t COMPACTION_MINIMUM = 1024;
+const std::string TEMPORARY_EXTENSION = ".tmp";
+
+
+/// Обрезает строку UTF-8 до указанной длины в байтах, не разрывая символы.
+std::string truncate(const std::string &text, std::size_t length)
+{
+    if (text.size() <= length)
+    {
+        return text;
+    }
+    // Продолжения многобайтовых символов имеют вид 10xxxxxx.
+    while (length > 0 && (std::uint8_t(text[length]) & 0xC0) == 0x80)
+    {
+        --length;
+    }
+    return text.substr(0, length);
+}
+
+
+/*!
+ * Записывает запись журнала без сброса буфера потока.
+ * \param[in] stream Получатель данных.
+ * \param[in] type Тип записи.
+ * \param[in] board Таблица.
+ * \param[in] cranesQuantity Количество кранов.
+ * \param[in] entry Результат.
+ */
+void writeRecord(
+    std::ostream &stream,
+    std::uint8_t type,
+    std::uint8_t board,
+    std::uint8_t cranesQuantity,
+    const Leaderboard::Entry &entry)
+{
+    std::array<char, Leaderboard::MAX_PLAYER_LENGTH> player{};
+    std::copy(entry.player.cbegin(), entry.player.cend(), player.begin());
+    BinaryWriter writer(stream);
+    writer.write(type);
+    writer.write(cranesQuantity);
+    writer.write(std::uint8_t(entry.player.size()));
+    writer.write(board);
+    writer.write(std::uint32_t(entry.score));
+    writer.write(entry.time);
+    stream.write(player.data(), std::streamsize(player.size()));
+}
+
+
+void writeHeader(std::ostream &stream)
+{
+    BinaryWriter writer(stream);
+    writer.write(LEADERBOARD_MAGIC);
+    writer.write(LEADERBOARD_VERSION);
+    writer.write(Leaderboard::RECORD_SIZE);
+}
+
+}
+
+
+Leaderboard& Leaderboard::instance()
+{
+    static Leaderboard singleton;
+    return singleton;
+}
+
+
+bool Leaderboard::open(const std::filesystem::path &path)
+{
+    // Записи, поставленные в очередь, дописываются в прежний журнал.
+    m_writer.submit([]() {}).wait();
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_file.close();
+    m_path = path;
+    m_tables = Tables();
+    m_recordsQuantity = 0;
+
+    // Отсутствующий или повреждённый журнал создаётся заново
+    // из прочитанных результатов.
+    const bool consistent = read();
+    m_journalTables = m_tables;
+    if (!consistent ||
+        m_recordsQuantity >
+            COMPACTION_RATIO * liveRecordsQuantity(m_tables) + COMPACTION_MINIMUM)
+    {
+        if (!compact(m_tables))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        m_file.open(m_path, std::ios::binary | std::ios::app);
+    }
+
+    if (!m_file.is_open())
+    {
+        LOG_ERROR("Failed to open leaderboard " << m_path << ".");
+        return false;
+    }
+    LOG_INFO(
+        "Leaderboard " << m_path << " has been read, "
+        << m_recordsQuantity << " records.");
+    return true;
+}
+
+
+void Leaderboard::add(
+    Board board,
+    std::uint8_t cranesQuantity,
+    const std::string &player,
+    unsigned int score)
+{
+    const Entry entry{
+        truncate(player, MAX_PLAYER_LENGTH),
+        score,
+        std::int64_t(std::time(nullptr)) };
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        apply(m_tables, RecordType::Score, board, cranesQuantity, entry);
+    }
+    m_writer.submit(
+        [this, board, cranesQuantity, entry]()
+        {
+            append(RecordType::Score, board, cranesQuantity, entry);
+        });
+}
+
+
+void Leaderboard::clear(Board board, std::uint8_t cranesQuantity)
+{
+    LOG_INFO(
+        "Clearing " << (board == Board::Bots ? "bots" : "players")
+        << " leaderboard for " << unsigned(cranesQuantity) << " cranes.");
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        apply(m_tables, RecordType::Clear, board, cranesQuantity, Entry());
+    }
+    m_writer.submit(
+        [this, board, cranesQuantity]()
+        {
+            append(RecordType::Clear, board, cranesQuantity, Entry());
+        });
+}
+
+
+std::vector<Leaderboard::Entry> Leaderboard::top(
+    Board board,
+    std::uint8_t cranesQuantity,
+    std::size_t quantity) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Entry> result;
+    const Table *table = Leaderboard::table(m_tables, board, cranesQuantity);
+    if (table == nullptr)
+    {
+        return result;
+    }
+    for (auto it = table->top.cbegin(); it != table->top.cend() && result.size() < quantity; ++it)
+    {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+
+std::optional<Leaderboard::Entry> Leaderboard::best(
+    Board board,
+    std::uint8_t cranesQuantity,
+    const std::string &player) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Table *table = Leaderboard::table(m_tables, board, cranesQuantity);
+    if (table == nullptr)
+    {
+        return std::nullopt;
+    }
+    const auto it = table->bests.find(truncate(player, MAX_PLAYER_LENGTH));
+    return it != table->bests.cend() ? std::make_optional(it->second) : std::nullopt;
+}
+
+
+bool Leaderboard::read()
+{
+    std::ifstream file(m_path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::array<std::uint8_t, RECORD_SIZE> buffer;
+    char *data = reinterpret_cast<char*>(buffer.data());
+    if (!file.read(data, HEADER_SIZE))
+    {
+        LOG_WARNING("Leaderboard " << m_path << " is truncated.");
+        return false;
+    }
+    const std::uint8_t *cursor = buffer.data();
+    const std::uint8_t *end = buffer.data() + HEADER_SIZE;
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0;
+    std::uint16_t recordSize = 0;
+    readLittleEndian(cursor, end, magic);
+    readLittleEndian(cursor, end, version);
+    readLittleEndian(cursor, end, recordSize);
+    if (magic != LEADERBOARD_MAGIC ||
+        version != LEADERBOARD_VERSION ||
+        recordSize != RECORD_SIZE)
+    {
+        LOG_WARNING("File " << m_path << " is not a leaderboard.");
+        return false;
+    }
+
+    while (file.read(data, RECORD_SIZE))
+    {
+        cursor = buffer.data();
+        end = buffer.data() + RECORD_SIZE;
+        std::uint8_t type = 0;
+        std::uint8_t cranesQuantity = 0;
+        std::uint8_t playerLength = 0;
+        std::uint8_t board = 0;
+        Entry entry;
+        readLittleEndian(cursor, end, type);
+        readLittleEndian(cursor, end, cranesQuantity);
+        readLittleEndian(cursor, end, playerLength);
+        readLittleEndian(cursor, end, board);
+        readLittleEndian(cursor, end, entry.score);
+        readLittleEndian(cursor, end, entry.time);
+        entry.player.assign(
+            reinterpret_cast<const char*>(cursor),
+            std::min(std::size_t(playerLength), MAX_PLAYER_LENGTH));
+        apply(m_tables, RecordType(type), Board(board), cranesQuantity, entry);
+        ++m_recordsQuantity;
+    }
+    if (file.gcount() != 0)
+    {
+        LOG_WARNING("Leaderboard " << m_path << " ends with a partial record.");
+        return false;
+    }
+    return true;
+}
+
+
+void Leaderboard::apply(
+    Tables &tables,
+    RecordType type,
+    Board board,
+    std::uint8_t cranesQuantity,
+    const Entry &entry)
+{
+    Table *table = Leaderboard::table(tables, board, cranesQuantity);
+    if (table == nullptr)
+    {
+        return;
+    }
+
+    switch (type)
+    {
+    case RecordType::Score:
+    {
+        if (table->top.size() < LEADERBOARD_SIZE ||
+            Rank()(entry, *std::prev(table->top.cend())))
+        {
+            table->top.insert(entry);
+            if (table->top.size() > LEADERBOARD_SIZE)
+            {
+                table->top.erase(std::prev(table->top.cend()));
+            }
+        }
+        const auto [it, inserted] = table->bests.try_emplace(entry.player, entry);
+        if (!inserted && entry.score > it->second.score)
+        {
+            it->second = entry;
+        }
+        break;
+    }
+    case RecordType::Clear:
+        *table = Table();
+        break;
+    }
+}
+
+
+void Leaderboard::append(
+    RecordType type,
+    Board board,
+    std::uint8_t cranesQuantity,
+    const Entry &entry)
+{
+    std::lock_guard<std::mutex> fileLock(m_fileMutex);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+
+    writeRecord(m_file, std::uint8_t(type), std::uint8_t(board), cranesQuantity, entry);
+    m_file.flush();
+    if (!m_file.good())
+    {
+        LOG_ERROR("Failed to write leaderboard " << m_path << ".");
+        return;
+    }
+
+    ++m_recordsQuantity;
+    apply(m_journalTables, type, board, cranesQuantity, entry);
+    if (m_recordsQuantity >
+        COMPACTION_RATIO * liveRecordsQuantity(m_journalTables) + COMPACTION_MINIMUM)
+    {
+        compact(m_journalTables);
+    }
+}
+
+
+bool Leaderboard::compact(const Tables &tables)
+{
+    m_file.close();
+    std::filesystem::path temporaryPath = m_path;
+    temporaryPath += TEMPORARY_EXTENSION;
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Failed to compact leaderboard " << m_path << ".");
+        return false;
+    }
+    writeHeader(file);
+    std::size_t recordsQuantity = 0;
+
+    // Записи накапливаются в буфере потока и записываются одним проходом.
+    const auto write = [&file, &recordsQuantity](
+        std::size_t board,
+        std::uint8_t cranesQuantity,
+        const Entry &entry)
+    {
+        writeRecord(
+            file,
+            std::uint8_t(RecordType::Score),
+            std::uint8_t(board),
+            cranesQuantity,
+            entry);
+        ++recordsQuantity;
+    };
+    for (std::size_t board = 0; board < tables.size(); ++board)
+    {
+        for (std::size_t i = 0; i < tables[board].size(); ++i)
+        {
+            const std::uint8_t cranesQuantity = std::uint8_t(i + 1);
+            const Table &table = tables[board][i];
+            for (const Entry &entry : table.top)
+            {
+                write(board, cranesQuantity, entry);
+            }
+            // Лучшие результаты игроков, не попавшие в таблицу.
+            for (const auto &[player, entry] : table.bests)
+            {
+                const auto [begin, end] = table.top.equal_range(entry);
+                if (std::none_of(
+                        begin,
+                        end,
+                        [&player = player](const Entry &top) { return top.player == player; }))
+                {
+                    write(board, cranesQuantity, entry);
+                }
+            }
+        }
+    }
+
+    file.close();
+    std::error_code error;
+    if (!file)
+    {
+        LOG_ERROR("Failed to compact leaderboard " << m_path << ".");
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    std::filesystem::rename(temporaryPath, m_path, error);
+    if (error)
+    {
+        LOG_ERROR("Failed to compact leaderboard " << m_path << ": " << error.message() << ".");
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    m_recordsQuantity = recordsQuantity;
+    m_file.open(m_path, std::ios::binary | std::ios::app);
+    LOG_DEBUG("Leaderboard has been compacted to " << m_recordsQuantity << " records.");
+    return true;
+}
+
+
+std::size_t Leaderboard::liveRecordsQuantity(const Tables &tables)
+{
+    std::size_t result = 0;
+    for (const auto &boardTables : tables)
+    {
+        for (const Table &table : boardTables)
+        {
+            result += table.top.size() + table.bests.size();
+        }
+    }
+    return result;
+}
+
+
+Leaderboard::Table* Leaderboard::table(
+    Tables &tables,
+    Board board,
+    std::uint8_t cranesQuantity)
+{
+    return std::size_t(board) < tables.size() &&
+        cranesQuantity >= 1 && cranesQuantity <= MAX_INITIAL_CRANES_QUANTITY
+        ? &tables[std::size_t(board)][cranesQuantity - 1]
+        : nullptr;
+}
+
+
+const Leaderboard::Table* Leaderboard::table(
+    const Tables &tables,
+    Board board,
+    std::uint8_t cranesQuantity)
+{
+    return std::size_t(board) < tables.size() &&
+        cranesQuantity >= 1 && cranesQuantity <= MAX_INITIAL_CRANES_QUANTITY
+        ? &tables[std::size_t(board)][cranesQuantity - 1]
+        : nullptr;
+}
@@ -0,0 +1,59 @@
+#include <game/loading_screen.h>
+
+#include <game/log.h>
+#include <game/resource_loader.h>
+
+
+LoadingScreen::LoadingScreen()
+{
+    ResourceLoader::instance().startLoading();
+}
+
+
+void LoadingScreen::update(const Duration&)
+{
+    ResourceLoader &resourceLoader = ResourceLoader::instance();
+    if (!resourceLoader.update())
+    {
+        LOG_ERROR("Failed to load resources.");
+        m_signalLoaded(false);
+        return;
+    }
+
+    if (!m_splashLoaded)
+    {
+        const TexturePtr splash =
+            resourceLoader.texture(ResourceLoader::TextureId::Splash);
+        if (splash != nullptr)
+        {
+            m_splash.setTexture(*splash, true);
+            m_splashLoaded = true;
+        }
+    }
+
+    if (resourceLoader.loaded())
+    {
+        m_signalLoaded(true);
+    }
+}
+
+
+bool LoadingScreen::handleKeyPressed(const sf::Keyboard::Key)
+{
+    return false;
+}
+
+
+void LoadingScreen::draw(sf::RenderTarget &target, sf::RenderStates) const
+{
+    if (m_splashLoaded)
+    {
+        target.draw(m_splash);
+    }
+}
+
+
+boost::signals2::connection LoadingScreen::connectLoaded(const Slot &slot)
+{
+    return m_signalLoaded.connect(slot);
+}
@@ -1,9 +1,7 @@
-#include <fstream>
-#include <iomanip>
+#include <algorithm>
 #include <iostream>
 
 #include <game/log.h>
-#include <game/clock.h>
 
 
 namespace
@@ -11,28 +9,11 @@ namespace
 
 const std::string LOG_FILE_NAME = "log";
 const std::string LOG_FILE_EXTENSION = ".txt";
-constexpr unsigned int CHECK_LOG_SIZE_PERIOD = 100;
 constexpr std::uintmax_t MAX_LOG_SIZE = 1024 * 1024 * 9; // Bytes.
-
-
-void writeToStream(
-    std::ostream &stream,
-    const std::string &message,
-    const Log::Severity severity,
-    const std::string &file,
-    const int line,
-    const std::string &functionName)
-{
-    std::ignore = file;
-    std::ignore = line;
-    std::ignore = functionName;
-
-    stream
-        << formatTime() << ' '
-        << std::setw(7) << std::right << severity << ": "
-        << message
-        << std::endl << std::flush;
-}
+/// The period of writing queued messages if nobody asks for a flush.
+constexpr std::chrono::milliseconds FLUSH_PERIOD(20);
+constexpr int SEVERITY_WIDTH = 7;
+const std::string TRUNCATION_MARK = "...";
 
 
 std::filesystem::path makeLogFilename(const std::filesystem::path &path)
@@ -40,19 +21,6 @@ std::filesystem::path makeLogFilename(const std::filesystem::path &path)
     return path / std::filesystem::path(LOG_FILE_NAME + LOG_FILE_EXTENSION);
 }
 
-
-void checkLogSize(const std::filesystem::path &filename)
-{
-    const std::uintmax_t size = std::filesystem::file_size(filename);
-    if (size >= MAX_LOG_SIZE)
-    {
-        std::filesystem::rename(
-            filename,
-            LOG_FILE_NAME + "_upto_" + formatTimeEscaped()
-                + LOG_FILE_EXTENSION);
-    }
-}
-
 }
 
 
@@ -74,15 +42,34 @@ Log& Log::instance()
 }
 
 
-void Log::setPath(const std::optional<std::filesystem::path> &path)
+Log::Log()
+{
+    // Started after all members are constructed.
+    m_thread = std::thread(&Log::run, this);
+}
+
+
+Log::~Log()
 {
-    if (!path.has_value())
     {
-        m_filename = std::nullopt;
-        return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
     }
+    m_wakeUp.notify_one();
+    m_thread.join();
+}
+
+
+void Log::setPath(const std::optional<std::filesystem::path> &path)
+{
+    // Messages written before the change go to the previous file.
+    flush();
 
-    m_filename = makeLogFilename(path.value());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_filename = path.has_value()
+        ? std::make_optional(makeLogFilename(path.value()))
+        : std::nullopt;
+    m_filenameChanged = true;
 }
 
 
@@ -99,42 +86,206 @@ void Log::write(
     const int line,
     const std::string &functionName)
 {
+    std::ignore = file;
+    std::ignore = line;
+    std::ignore = functionName;
+
     if (severity < m_minimumSeverity)
     {
         return;
     }
 
+    Record record;
+    record.time = std::chrono::system_clock::now();
+    record.severity = severity;
+    if (message.size() <= LOG_RECORD_SIZE)
+    {
+        record.length = std::uint16_t(message.size());
+        std::copy(message.cbegin(), message.cend(), record.text.begin());
+    }
+    else
+    {
+        const std::size_t length = LOG_RECORD_SIZE - TRUNCATION_MARK.size();
+        std::copy_n(message.cbegin(), length, record.text.begin());
+        std::copy(
+            TRUNCATION_MARK.cbegin(),
+            TRUNCATION_MARK.cend(),
+            record.text.begin() + length);
+        record.length = std::uint16_t(LOG_RECORD_SIZE);
+    }
+
+    if (severity == Severity::Fatal)
+    {
+        // A fatal message is never dropped: the queue is drained
+        // until there is room for it.
+        while (!m_queue.push(record))
+        {
+            flush();
+        }
+        flush();
+        return;
+    }
+    if (!m_queue.push(record))
+    {
+        m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+void Log::flush()
+{
+    const std::size_t quantity = m_queue.pushed();
     std::unique_lock<std::mutex> lock(m_mutex);
+    m_flushRequested = true;
+    m_wakeUp.notify_one();
+    m_flushed.wait(
+        lock,
+        [this, quantity]() { return m_flushedQuantity >= quantity || m_stopping; });
+}
+
+
+std::uint64_t Log::droppedMessages() const noexcept
+{
+    return m_droppedMessages.load(std::memory_order_relaxed);
+}
+
+
+void Log::run()
+{
+    Record record;
+    for (;;)
+    {
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait_for(
+                lock,
+                FLUSH_PERIOD,
+                [this]() { return m_flushRequested || m_stopping; });
+            m_flushRequested = false;
+            stopping = m_stopping;
+            if (m_filenameChanged)
+            {
+                m_openFilename = m_filename;
+                m_filenameChanged = false;
+                m_file.close();
+            }
+        }
+
+        if (m_openFilename.has_value() && !m_file.is_open())
+        {
+            openFile();
+        }
+        while (m_queue.pop(record))
+        {
+            writeRecord(record);
+        }
+        reportDroppedMessages();
+        flushStreams();
+        checkLogSize();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_flushedQuantity = m_queue.popped();
+        }
+        m_flushed.notify_all();
+
+        if (stopping)
+        {
+            return;
+        }
+    }
+}
+
+
+void Log::writeRecord(const Record &record)
+{
+    // Formatting local time is expensive, so it's done once per second.
+    const std::time_t second = std::chrono::system_clock::to_time_t(record.time);
+    if (second != m_cachedSecond)
+    {
+        m_cachedSecond = second;
+        m_cachedTime = formatTime(record.time);
+    }
+
+    const std::string &severity = SEVERITY_DESCRIPTIONS[record.severity];
+    m_line.assign(m_cachedTime);
+    m_line.append(
+        std::size_t(std::max(0, SEVERITY_WIDTH - int(severity.size()))) + 1,
+        ' ');
+    m_line.append(severity);
+    m_line.append(": ");
+    m_line.append(record.text.data(), record.length);
+    m_line.push_back('\n');
 
-    std::ostream &stream = severity <= Log::Severity::Warning
+    std::ostream &stream = record.severity <= Log::Severity::Warning
         ? std::cout
         : std::cerr;
-    writeToStream(stream, message, severity, file, line, functionName);
-
-    writeToFile(message, severity, file, line, functionName);
+    stream.write(m_line.data(), std::streamsize(m_line.size()));
+    if (m_file.is_open())
+    {
+        m_file.write(m_line.data(), std::streamsize(m_line.size()));
+        m_fileSize += m_line.size();
+    }
 }
 
 
-void Log::writeToFile(
-    const std::string &message,
-    const Log::Severity severity,
-    const std::string &file,
-    const int line,
-    const std::string &functionName)
+void Log::reportDroppedMessages()
 {
-    if (!m_filename.has_value())
+    const std::uint64_t dropped = droppedMessages();
+    if (dropped == m_reportedDroppedMessages)
     {
         return;
     }
 
-    if (CHECK_LOG_SIZE_PERIOD == 0 ||
-        ++m_lastLogSizeCheck == CHECK_LOG_SIZE_PERIOD)
+    Record record;
+    record.time = std::chrono::system_clock::now();
+    record.severity = Severity::Warning;
+    const std::string message =
+        "Log queue overflow, " + std::to_string(dropped - m_reportedDroppedMessages)
+        + " messages dropped.";
+    record.length = std::uint16_t(message.size());
+    std::copy(message.cbegin(), message.cend(), record.text.begin());
+    writeRecord(record);
+    m_reportedDroppedMessages = dropped;
+}
+
+
+void Log::flushStreams()
+{
+    std::cout.flush();
+    std::cerr.flush();
+    if (m_file.is_open())
+    {
+        m_file.flush();
+    }
+}
+
+
+void Log::openFile()
+{
+    const std::filesystem::path &filename = m_openFilename.value();
+    m_file.open(filename, std::ios::app);
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(filename, error);
+    m_fileSize = error ? 0 : size;
+}
+
+
+void Log::checkLogSize()
+{
+    if (!m_file.is_open() || m_fileSize < MAX_LOG_SIZE)
     {
-        checkLogSize(m_filename.value());
-        m_lastLogSizeCheck = 0;
+        return;
     }
 
-    std::ofstream fstream(m_filename.value(), std::ios::app);
-    writeToStream(fstream, message, severity, file, line, functionName);
-    fstream.close();
+    m_file.close();
+    const std::filesystem::path &filename = m_openFilename.value();
+    std::error_code error;
+    std::filesystem::rename(
+        filename,
+        filename.parent_path() /
+            (LOG_FILE_NAME + "_upto_" + formatTimeEscaped() + LOG_FILE_EXTENSION),
+        error);
+    openFile();
 }
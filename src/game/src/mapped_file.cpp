@@ -0,0 +1,150 @@
+#include <game/mapped_file.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <game/log.h>
+
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::filesystem::path &path)
+{
+    close();
+
+    const HANDLE file = CreateFileW(
+        path.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("Failed to open file " << path << ".");
+        return false;
+    }
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        LOG_ERROR("Failed to get size of file " << path << ".");
+        close();
+        return false;
+    }
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        LOG_ERROR("Failed to map file " << path << ".");
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(
+        MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        LOG_ERROR("Failed to map file " << path << ".");
+        close();
+        return false;
+    }
+    m_size = std::size_t(size.QuadPart);
+    return true;
+}
+
+
+void MappedFile::close() noexcept
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != nullptr)
+    {
+        CloseHandle(m_file);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::filesystem::path &path)
+{
+    close();
+
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        LOG_ERROR("Failed to open file " << path << ".");
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        LOG_ERROR("Failed to get size of file " << path << ".");
+        ::close(file);
+        return false;
+    }
+
+    const std::size_t size = std::size_t(status.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    // Отображение остаётся действительным после закрытия дескриптора.
+    ::close(file);
+    if (data == MAP_FAILED)
+    {
+        LOG_ERROR("Failed to map file " << path << ".");
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = size;
+    return true;
+}
+
+
+void MappedFile::close() noexcept
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+
+const std::uint8_t* MappedFile::data() const noexcept
+{
+    return m_data;
+}
+
+
+std::size_t MappedFile::size() const noexcept
+{
+    return m_size;
+}
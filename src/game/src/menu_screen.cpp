@@ -1,13 +1,14 @@
 #include <game/menu_screen.h>
 
 #include <game/config.h>
+#include <game/leaderboard.h>
 #include <game/log.h>
 #include <game/resource_loader.h>
-#include <game/serializer.h>
 #include <game/sound_system.h>
 
 
-MenuScreen::MenuScreen()
+MenuScreen::MenuScreen(bool resumable)
+    : m_resumable(resumable)
 {
     setup();
 }
@@ -62,7 +63,10 @@ std::unique_ptr<MenuStart> MenuScreen::makeMenuStart()
 {
     std::unique_ptr<MenuStart> menuStart = std::make_unique<MenuStart>();
     menuStart->connectClose(boost::bind(&MenuScreen::exit, this));
-    menuStart->connectStart(boost::bind(&MenuScreen::startGame, this));
+    menuStart->connectStart(boost::bind(
+        m_resumable ? &MenuScreen::resumeGame : &MenuScreen::startGame,
+        this));
+    menuStart->setResumable(m_resumable);
     menuStart->connectOptions(boost::bind(&MenuScreen::setMenuOptions, this));
     return menuStart;
 }
@@ -86,7 +90,7 @@ std::unique_ptr<MenuOptions> MenuScreen::makeMenuOptions()
         boost::bind(&MenuScreen::setMenuSelectLevel, this));
     menuOptions->connectViewHighScore(
         boost::bind(&MenuScreen::setMenuHighScore, this));
-    menuOptions->setSoundEnabled(Config::instance().sound);
+    menuOptions->setSoundEnabled(Config::instance().sound());
     return menuOptions;
 }
 
@@ -101,7 +105,6 @@ void MenuScreen::setMenuOptions()
 void MenuScreen::closeMenuOptions()
 {
     saveSoundSetting();
-    writeConfig();
     setMenuStart();
 }
 
@@ -109,7 +112,6 @@ void MenuScreen::closeMenuOptions()
 void MenuScreen::closeMenuOptionsAndStart()
 {
     saveSoundSetting();
-    writeConfig();
     startGame();
 }
 
@@ -118,7 +120,7 @@ void MenuScreen::saveSoundSetting()
 {
     const MenuOptions *menuOptions = static_cast<MenuOptions*>(m_menu.get());
     LOG_DEBUG("Set sound enabled: " << menuOptions->soundEnabled() << ".");
-    Config::instance().sound = menuOptions->soundEnabled();
+    Config::instance().setSound(menuOptions->soundEnabled());
     SoundSystem::instance().setEnabled(menuOptions->soundEnabled());
 }
 
@@ -127,7 +129,7 @@ std::unique_ptr<MenuLevel> MenuScreen::makeMenuLevel()
 {
     std::unique_ptr<MenuLevel> menuLevel = std::make_unique<MenuLevel>();
     menuLevel->connectClose(boost::bind(&MenuScreen::closeMenuLevel, this));
-    menuLevel->setSelectedItem(Config::instance().cranesQuantity - 1);
+    menuLevel->setSelectedItem(Config::instance().cranesQuantity() - 1);
     return menuLevel;
 }
 
@@ -142,8 +144,9 @@ void MenuScreen::setMenuSelectLevel()
 void MenuScreen::closeMenuLevel()
 {
     const MenuLevel *menuLevel = static_cast<MenuLevel*>(m_menu.get());
-    Config::instance().cranesQuantity = menuLevel->selectedItem() + 1;
-    LOG_DEBUG("Set level: " << int(Config::instance().cranesQuantity) << ".");
+    Config::instance().setCranesQuantity(
+        std::uint8_t(menuLevel->selectedItem() + 1));
+    LOG_DEBUG("Set level: " << int(Config::instance().cranesQuantity()) << ".");
 
     setMenuOptions();
 }
@@ -155,7 +158,10 @@ std::unique_ptr<MenuHighScore> MenuScreen::makeMenuHighScore()
         std::make_unique<MenuHighScore>();
     menuHighScore->connectClose(
         boost::bind(&MenuScreen::closeMenuHighScore, this));
-    menuHighScore->setHighScore(Config::instance().highScore);
+    menuHighScore->setEntries(Leaderboard::instance().top(
+        Leaderboard::Board::Players,
+        Config::instance().cranesQuantity(),
+        HIGH_SCORE_ROWS_QUANTITY));
     return menuHighScore;
 }
 
@@ -171,10 +177,13 @@ void MenuScreen::closeMenuHighScore()
 {
     const MenuHighScore *menuHighScore =
         static_cast<MenuHighScore*>(m_menu.get());
-    Config::instance().highScore = menuHighScore->highScore();
-    LOG_DEBUG(
-        "Set high score to "
-        << unsigned(Config::instance().highScore) << ".");
+    if (menuHighScore->cleared())
+    {
+        Leaderboard::instance().clear(
+            Leaderboard::Board::Players,
+            Config::instance().cranesQuantity());
+        LOG_DEBUG("High score deleted.");
+    }
 
     setMenuOptions();
 }
@@ -183,12 +192,19 @@ void MenuScreen::closeMenuHighScore()
 void MenuScreen::startGame()
 {
     LOG_DEBUG("Start game requested.");
-    m_signalClose(true);
+    m_signalClose(Result::Start);
+}
+
+
+void MenuScreen::resumeGame()
+{
+    LOG_DEBUG("Resume game requested.");
+    m_signalClose(Result::Resume);
 }
 
 
 void MenuScreen::exit()
 {
     LOG_DEBUG("Exit requested.");
-    m_signalClose(false);
+    m_signalClose(Result::Exit);
 }
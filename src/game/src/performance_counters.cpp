@@ -0,0 +1,186 @@
+#include <game/performance_counters.h>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <game/log.h>
+
+
+namespace
+{
+
+#ifdef __linux__
+/// Аппаратные события в порядке полей PerformanceCounters::Values.
+constexpr std::array<std::uint64_t, 4> EVENTS =
+{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+const std::array<const char*, 4> EVENT_NAMES =
+{
+    "cycles",
+    "instructions",
+    "cache misses",
+    "branch misses"
+};
+
+
+/*!
+ * Открывает счётчик вызывающего потока, считающий только код
+ * пользовательского режима.
+ * \param[in] event Аппаратное событие.
+ * \param[in] groupDescriptor Дескриптор ведущего счётчика группы
+ * либо -1 для открытия ведущего счётчика.
+ * \return Дескриптор счётчика либо -1.
+ */
+int openCounter(std::uint64_t event, int groupDescriptor)
+{
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = event;
+    // Группа запускается целиком после открытия всех счётчиков.
+    attributes.disabled = groupDescriptor == -1 ? 1 : 0;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // Время включения и работы группы нужно для масштабирования значений,
+    // если ядро поочерёдно делит аппаратные счётчики между группами.
+    attributes.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return int(syscall(
+        SYS_perf_event_open,
+        &attributes,
+        0, // Вызывающий поток.
+        -1, // Любой процессор.
+        groupDescriptor,
+        PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+}
+
+
+PerformanceCounters& PerformanceCounters::thread()
+{
+    thread_local PerformanceCounters counters;
+    return counters;
+}
+
+
+bool PerformanceCounters::open()
+{
+    if (opened())
+    {
+        return true;
+    }
+#ifdef __linux__
+    for (std::size_t i = 0; i < COUNTERS_QUANTITY; ++i)
+    {
+        const int descriptor = openCounter(EVENTS[i], m_leader);
+        if (descriptor == -1)
+        {
+            LOG_WARNING(
+                "Performance counter of " << EVENT_NAMES[i] << " is not available: "
+                << std::strerror(errno) << '.');
+            if (i == 0)
+            {
+                LOG_WARNING(
+                    "Performance counters are disabled. Access is controlled by "
+                    "/proc/sys/kernel/perf_event_paranoid.");
+                return false;
+            }
+            continue;
+        }
+        if (i == 0)
+        {
+            m_leader = descriptor;
+        }
+        m_descriptors[i] = descriptor;
+        m_positions[i] = m_quantity++;
+    }
+    ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    LOG_WARNING("Performance counters are supported on Linux only.");
+    return false;
+#endif
+}
+
+
+void PerformanceCounters::close() noexcept
+{
+#ifdef __linux__
+    for (int &descriptor : m_descriptors)
+    {
+        if (descriptor != -1)
+        {
+            ::close(descriptor);
+            descriptor = -1;
+        }
+    }
+#endif
+    m_leader = -1;
+    m_quantity = 0;
+}
+
+
+PerformanceCounters::Values PerformanceCounters::read() const noexcept
+{
+    Values result;
+#ifdef __linux__
+    if (!opened())
+    {
+        return result;
+    }
+    // Формат PERF_FORMAT_GROUP с PERF_FORMAT_TOTAL_TIME_ENABLED
+    // и PERF_FORMAT_TOTAL_TIME_RUNNING: количество счётчиков,
+    // время включения группы, время её работы и значения счётчиков.
+    std::array<std::uint64_t, COUNTERS_QUANTITY + 3> buffer{};
+    if (::read(m_leader, buffer.data(), sizeof(buffer)) <= 0)
+    {
+        return result;
+    }
+    const std::uint64_t timeEnabled = buffer[1];
+    const std::uint64_t timeRunning = buffer[2];
+    if (timeRunning == 0)
+    {
+        // Группа ещё не получила аппаратные счётчики.
+        return result;
+    }
+    const double scale = double(timeEnabled) / double(timeRunning);
+    const auto value = [this, &buffer, scale](std::size_t counter) -> std::uint64_t
+    {
+        return m_descriptors[counter] != -1
+            ? std::uint64_t(double(buffer[3 + m_positions[counter]]) * scale)
+            : 0;
+    };
+    result.cycles = value(0);
+    result.instructions = value(1);
+    result.cacheMisses = value(2);
+    result.branchMisses = value(3);
+#endif
+    return result;
+}
+
+
+PerformanceCounters::PerformanceCounters()
+{
+    m_descriptors.fill(-1);
+}
+
+
+PerformanceCounters::~PerformanceCounters()
+{
+    close();
+}
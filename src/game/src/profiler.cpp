@@ -0,0 +1,145 @@
+#include <game/profiler.h>
+
+
+#ifdef PROFILER_ENABLED
+
+#include <algorithm>
+
+
+const std::array<std::string, Profiler::ZONES_QUANTITY> Profiler::ZONE_NAMES =
+{
+    "Game::update",
+    "Window events",
+    "updatePlayer",
+    "updateBoxes",
+    "updateCrane",
+    "World::draw",
+    "Window::endDraw"
+};
+
+
+Profiler& Profiler::instance()
+{
+    static Profiler singleton;
+    return singleton;
+}
+
+
+void Profiler::endFrame()
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const AllocationTracker::Counters allocations = AllocationTracker::total();
+    const PerformanceCounters::Values counters = PerformanceCounters::thread().read();
+    // Первый кадр измеряется от первого вызова.
+    if (m_frameStart.has_value())
+    {
+        const AllocationTracker::Counters frameAllocations =
+            allocations - m_frameStartAllocations;
+        const PerformanceCounters::Values frameCounters = counters - m_frameStartCounters;
+        const std::array<std::int64_t, METRICS_QUANTITY> frame =
+        {
+            std::chrono::nanoseconds(now - m_frameStart.value()).count(),
+            std::int64_t(frameAllocations.allocations),
+            std::int64_t(frameAllocations.bytes),
+            std::int64_t(frameCounters.cycles),
+            std::int64_t(frameCounters.instructions),
+            std::int64_t(frameCounters.cacheMisses),
+            std::int64_t(frameCounters.branchMisses)
+        };
+        for (std::size_t metric = 0; metric < METRICS_QUANTITY; ++metric)
+        {
+            m_frameHistories[metric][m_position] = frame[metric];
+            for (std::size_t zone = 0; zone < ZONES_QUANTITY; ++zone)
+            {
+                m_zoneHistories[zone][metric][m_position] =
+                    m_current[zone][metric].exchange(0, std::memory_order_relaxed);
+            }
+        }
+        m_position = (m_position + 1) % PROFILER_HISTORY_SIZE;
+        m_size = std::min(m_size + 1, PROFILER_HISTORY_SIZE);
+    }
+    else
+    {
+        for (auto &zone : m_current)
+        {
+            for (std::atomic<std::int64_t> &value : zone)
+            {
+                value.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    m_frameStart = now;
+    m_frameStartAllocations = allocations;
+    m_frameStartCounters = counters;
+}
+
+
+Profiler::Statistics Profiler::statistics(Zone zone) const
+{
+    return statistics(m_zoneHistories[std::size_t(zone)]);
+}
+
+
+Profiler::Statistics Profiler::frameStatistics() const
+{
+    return statistics(m_frameHistories);
+}
+
+
+Profiler::History Profiler::frameHistory() const
+{
+    History result{};
+    const std::size_t first =
+        (m_position + PROFILER_HISTORY_SIZE - m_size) % PROFILER_HISTORY_SIZE;
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        result[i] = m_frameHistories[std::size_t(Metric::Time)][(first + i) % PROFILER_HISTORY_SIZE];
+    }
+    return result;
+}
+
+
+std::size_t Profiler::historySize() const noexcept
+{
+    return m_size;
+}
+
+
+Profiler::Statistics Profiler::statistics(const Histories &histories) const
+{
+    Statistics result;
+    if (m_size == 0)
+    {
+        return result;
+    }
+
+    const History &time = histories[std::size_t(Metric::Time)];
+    result.average = std::chrono::nanoseconds(std::int64_t(average(time)));
+    result.allocations = average(histories[std::size_t(Metric::Allocations)]);
+    result.bytes = average(histories[std::size_t(Metric::Bytes)]);
+    result.cycles = average(histories[std::size_t(Metric::Cycles)]);
+    result.instructions = average(histories[std::size_t(Metric::Instructions)]);
+    result.cacheMisses = average(histories[std::size_t(Metric::CacheMisses)]);
+    result.branchMisses = average(histories[std::size_t(Metric::BranchMisses)]);
+
+    // Порядок кадров для статистики не важен: заполнены первые m_size
+    // элементов, пока история не заполнится целиком.
+    History values = time;
+    const std::size_t p99Index = (m_size * 99) / 100;
+    std::nth_element(values.begin(), values.begin() + p99Index, values.begin() + m_size);
+    result.p99 = std::chrono::nanoseconds(values[p99Index]);
+    return result;
+}
+
+
+double Profiler::average(const History &history) const
+{
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        sum += history[i];
+    }
+    return double(sum) / double(m_size);
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,172 @@
+#include <game/replay.h>
+
+#include <fstream>
+
+#include <game/binary_io.h>
+#include <game/log.h>
+
+
+namespace
+{
+
+/// Сигнатура файла записи игры.
+constexpr std::uint32_t REPLAY_MAGIC = 0x52544B53; // "SKTR"
+/// Версия формата файла записи игры.
+constexpr std::uint16_t REPLAY_VERSION = 2;
+
+}
+
+
+void Replay::addTick(const Duration &elapsed)
+{
+    if (!intervals.empty() && intervals.back().elapsed == elapsed)
+    {
+        ++intervals.back().ticks;
+        return;
+    }
+    intervals.push_back(Interval{ 1, elapsed });
+}
+
+
+std::uint32_t Replay::ticks() const noexcept
+{
+    std::uint32_t result = 0;
+    for (const Interval &interval : intervals)
+    {
+        result += interval.ticks;
+    }
+    return result;
+}
+
+
+bool writeReplay(const std::filesystem::path &path, const Replay &replay)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        LOG_ERROR("Failed to open replay file " << path << " for writing.");
+        return false;
+    }
+
+    BinaryWriter writer(file);
+    writer.write(REPLAY_MAGIC);
+    writer.write(REPLAY_VERSION);
+    writeReplay(writer, replay);
+
+    if (!writer.good())
+    {
+        LOG_ERROR("Failed to write replay file " << path << ".");
+        return false;
+    }
+    LOG_INFO("Replay has been written into " << path << ".");
+    return true;
+}
+
+
+bool readReplay(const std::filesystem::path &path, Replay &replay)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        LOG_ERROR("Failed to open replay file " << path << ".");
+        return false;
+    }
+
+    BinaryReader reader(file);
+    std::uint32_t magic{ 0 };
+    std::uint16_t version{ 0 };
+    reader.read(magic);
+    reader.read(version);
+    if (magic != REPLAY_MAGIC || version != REPLAY_VERSION)
+    {
+        LOG_ERROR(
+            "File " << path << " is not a replay of version "
+            << REPLAY_VERSION << '.');
+        return false;
+    }
+
+    if (!readReplay(reader, replay))
+    {
+        LOG_ERROR("Replay file " << path << " is truncated.");
+        return false;
+    }
+
+    LOG_INFO(
+        "Replay has been read from " << path << ": "
+        << replay.ticks() << " ticks, " << replay.inputs.size() << " inputs.");
+    return true;
+}
+
+
+void writeReplay(BinaryWriter &writer, const Replay &replay)
+{
+    writer.write(replay.seed);
+    writer.write(replay.positionIndex.has_value());
+    writer.write(std::uint32_t(replay.positionIndex.value_or(0)));
+    writer.write(replay.cranesQuantity);
+    writer.write(replay.debugMode);
+
+    writer.write(std::uint32_t(replay.intervals.size()));
+    for (const Replay::Interval &interval : replay.intervals)
+    {
+        writer.write(interval.ticks);
+        writer.write(interval.elapsed.count());
+    }
+
+    writer.write(std::uint32_t(replay.inputs.size()));
+    for (const Replay::Input &input : replay.inputs)
+    {
+        writer.write(input.tick);
+        writer.write(std::int32_t(input.key));
+        writer.write(input.pressed);
+    }
+}
+
+
+bool readReplay(BinaryReader &reader, Replay &replay)
+{
+    Replay result;
+    bool hasPosition{ false };
+    std::uint32_t positionIndex{ 0 };
+    reader.read(result.seed);
+    reader.read(hasPosition);
+    reader.read(positionIndex);
+    reader.read(result.cranesQuantity);
+    reader.read(result.debugMode);
+    if (hasPosition)
+    {
+        result.positionIndex = positionIndex;
+    }
+
+    std::uint32_t size{ 0 };
+    reader.read(size);
+    for (std::uint32_t i = 0; i < size && reader.good(); ++i)
+    {
+        Replay::Interval interval{ 0, Duration() };
+        Duration::rep elapsed{ 0 };
+        reader.read(interval.ticks);
+        reader.read(elapsed);
+        interval.elapsed = Duration(elapsed);
+        result.intervals.push_back(interval);
+    }
+
+    size = 0;
+    reader.read(size);
+    for (std::uint32_t i = 0; i < size && reader.good(); ++i)
+    {
+        Replay::Input input{ 0, sf::Keyboard::Key::Unknown, false };
+        std::int32_t key{ 0 };
+        reader.read(input.tick);
+        reader.read(key);
+        reader.read(input.pressed);
+        input.key = sf::Keyboard::Key(key);
+        result.inputs.push_back(input);
+    }
+
+    if (!reader.good())
+    {
+        return false;
+    }
+    replay = std::move(result);
+    return true;
+}
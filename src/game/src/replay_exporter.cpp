@@ -0,0 +1,164 @@
+#include <game/replay_exporter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <game/bounded_queue.h>
+#include <game/consts.h>
+#include <game/log.h>
+#include <game/world.h>
+#include <game/graphics/software_renderer.h>
+
+
+namespace
+{
+
+/// Продолжительность экспорта после окончания записи,
+/// чтобы в ролик попала анимация гибели игрока и итоговый счёт.
+const Duration EXPORT_TAIL_DURATION(3);
+/// Количество кадров в очереди на кодирование на каждый поток кодирования.
+constexpr std::size_t FRAMES_PER_ENCODER = 4;
+
+
+struct Frame
+{
+    std::uint32_t index;
+    std::vector<std::uint8_t> pixels;
+};
+
+
+std::size_t encodersQuantity()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}
+
+
+ReplayExporter::ReplayExporter(const std::filesystem::path &directory)
+    : m_directory(directory)
+{
+}
+
+
+bool ReplayExporter::exportReplay(const Replay &replay)
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error)
+    {
+        LOG_ERROR(
+            "Failed to create directory " << m_directory
+            << ": " << error.message() << '.');
+        return false;
+    }
+
+    if (replay.intervals.empty())
+    {
+        LOG_ERROR("Replay is empty.");
+        return false;
+    }
+
+    const std::size_t encoders = encodersQuantity();
+    BoundedQueue<Frame> queue(encoders * FRAMES_PER_ENCODER);
+    std::atomic<std::uint32_t> failures{ 0 };
+    std::vector<std::thread> threads;
+    threads.reserve(encoders);
+    for (std::size_t i = 0; i < encoders; ++i)
+    {
+        threads.emplace_back(
+            [this, &queue, &failures]()
+            {
+                sf::Image image;
+                while (std::optional<Frame> frame = queue.pop())
+                {
+                    image.create(
+                        SCREEN_SIZE.x,
+                        SCREEN_SIZE.y,
+                        frame.value().pixels.data());
+                    if (!image.saveToFile(framePath(frame.value().index).string()))
+                    {
+                        ++failures;
+                    }
+                }
+            });
+    }
+
+    const TimePoint begin = Clock::now();
+    World world;
+    world.start(replay);
+    SoftwareRenderer renderer;
+    const std::size_t frameSize =
+        SoftwareRenderer::frameSize(SoftwareRenderer::PixelFormat::Rgba);
+
+    std::uint32_t tick = 0;
+    auto input = replay.inputs.cbegin();
+    const auto renderTick = [&](const Duration &elapsed)
+    {
+        for (; input != replay.inputs.cend() && input->tick == tick; ++input)
+        {
+            if (input->pressed)
+            {
+                world.handleKeyPressed(input->key);
+            }
+            else
+            {
+                world.handleKeyReleased(input->key);
+            }
+        }
+        world.update(elapsed);
+
+        Frame frame{ tick, std::vector<std::uint8_t>(frameSize) };
+        renderer.render(world, frame.pixels.data());
+        queue.push(std::move(frame));
+        ++tick;
+    };
+
+    for (const Replay::Interval &interval : replay.intervals)
+    {
+        for (std::uint32_t i = 0; i < interval.ticks; ++i)
+        {
+            renderTick(interval.elapsed);
+        }
+    }
+    const Duration lastElapsed = replay.intervals.back().elapsed;
+    for (Duration tail{ 0 };
+         lastElapsed > Duration() && tail < EXPORT_TAIL_DURATION;
+         tail += lastElapsed)
+    {
+        renderTick(lastElapsed);
+    }
+
+    queue.close();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    const Duration duration = Clock::now() - begin;
+    LOG_INFO(
+        "Exported " << tick << " frames into " << m_directory
+        << " in " << duration.count() << " s ("
+        << tick / std::max(duration.count(), 1e-9) << " frames/s, "
+        << encoders << " encoders).");
+    if (failures != 0)
+    {
+        LOG_ERROR("Failed to save " << failures << " frames.");
+        return false;
+    }
+    return true;
+}
+
+
+std::filesystem::path ReplayExporter::framePath(std::uint32_t index) const
+{
+    std::ostringstream name;
+    name << "frame_" << std::setw(6) << std::setfill('0') << index << ".png";
+    return m_directory / name.str();
+}
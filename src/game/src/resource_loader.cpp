@@ -1,33 +1,170 @@
 #include <game/resource_loader.h>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <vector>
 
+#include <game/asset_cache.h>
 #include <game/log.h>
+#include <game/mapped_file.h>
+#include <game/resource_pack.h>
+#include <game/thread_pool.h>
+#include <game/tracer.h>
 
 
 namespace
 {
 
 const std::filesystem::path RESOURCES_DIR("resources");
-const std::filesystem::path PATH_GRAPHICS = RESOURCES_DIR / "graphics";
-const std::filesystem::path PATH_AUDIO = RESOURCES_DIR / "audio";
+const std::filesystem::path CACHE_DIR("cache");
+const std::filesystem::path RESOURCE_PACK_FILE_NAME("resources.pak");
 
-const std::string TEXTURE_SPLASH("splash.png");
-const std::string TEXTURE_BACKGROUND("background.png");
-const std::string TEXTURE_BOX("box.png");
-const std::string TEXTURE_CRANE("crane.png");
-const std::string TEXTURE_FOREGROUND("foreground.png");
-const std::string TEXTURE_PLAYER("player.png");
-const std::string TEXTURE_FONT("font.png");
-const std::string TEXTURE_FRAME("frame.png");
-const std::string TEXTURE_HOURGLASS("hourglass.png");
+/// Файлы текстур. Заставка идёт первой, чтобы быть готовой раньше остальных.
+const std::vector<std::pair<ResourceLoader::TextureId, std::string>> TEXTURE_FILES =
+{
+    { ResourceLoader::TextureId::Splash, "graphics/splash.png" },
+    { ResourceLoader::TextureId::Font, "graphics/font.png" },
+    { ResourceLoader::TextureId::Frame, "graphics/frame.png" },
+    { ResourceLoader::TextureId::Background, "graphics/background.png" },
+    { ResourceLoader::TextureId::Foreground, "graphics/foreground.png" },
+    { ResourceLoader::TextureId::Box, "graphics/box.png" },
+    { ResourceLoader::TextureId::Player, "graphics/player.png" },
+    { ResourceLoader::TextureId::Crane, "graphics/crane.png" },
+    { ResourceLoader::TextureId::Hourglass, "graphics/hourglass.png" }
+};
+
+const std::vector<std::pair<ResourceLoader::SoundId, std::string>> SOUND_FILES =
+{
+    { ResourceLoader::SoundId::Jump, "audio/jump.ogg" },
+    { ResourceLoader::SoundId::Land, "audio/land.ogg" },
+    { ResourceLoader::SoundId::Push, "audio/push.ogg" },
+    { ResourceLoader::SoundId::Blow, "audio/blow.ogg" },
+    { ResourceLoader::SoundId::Score, "audio/score.ogg" },
+    { ResourceLoader::SoundId::GameOver, "audio/game_over.ogg" }
+};
+
+
+/*!
+ * Находит содержимое исходного файла ресурса: в архиве ресурсов, если он
+ * открыт, иначе - в файле каталога ресурсов, отображаемом в память.
+ * \param[in] pack Архив ресурсов.
+ * \param[in] name Имя ресурса.
+ * \param[out] file Отображённый файл, если архива нет.
+ * \param[out] source Содержимое исходного файла.
+ * \return \c false, если ресурс не найден.
+ */
+bool findSource(
+    const std::shared_ptr<const ResourcePack> &pack,
+    const std::string &name,
+    MappedFile &file,
+    ResourcePack::Blob &source)
+{
+    if (pack == nullptr)
+    {
+        if (!file.open(RESOURCES_DIR / name))
+        {
+            return false;
+        }
+        source = ResourcePack::Blob{ file.data(), file.size() };
+        return true;
+    }
+
+    const ResourcePack::Blob *blob = pack->find(name);
+    if (blob == nullptr)
+    {
+        LOG_ERROR("Resource \"" << name << "\" is missing in resource pack.");
+        return false;
+    }
+    source = *blob;
+    return true;
+}
+
+
+/*!
+ * Загружает изображение из кэша декодированных ресурсов либо декодирует
+ * его и обновляет кэш.
+ */
+ImagePtr decodeImage(
+    const std::shared_ptr<const ResourcePack> &pack,
+    const std::shared_ptr<const AssetCache> &cache,
+    const std::string &name)
+{
+    TRACE_SCOPE("decodeImage");
+    MappedFile file;
+    ResourcePack::Blob source;
+    if (!findSource(pack, name, file, source))
+    {
+        LOG_ERROR("Could not load resource \"" << name << "\".");
+        return nullptr;
+    }
+
+    const std::uint64_t sourceHash = AssetCache::hash(source.data, source.size);
+    if (ImagePtr image = cache->loadImage(name, sourceHash))
+    {
+        return image;
+    }
+
+    std::shared_ptr<sf::Image> image = std::make_shared<sf::Image>();
+    if (!image->loadFromMemory(source.data, source.size))
+    {
+        LOG_ERROR("Could not load resource \"" << name << "\".");
+        return nullptr;
+    }
+    cache->storeImage(name, sourceHash, *image);
+    return image;
+}
+
+/*!
+ * Загружает звук из кэша декодированных ресурсов либо декодирует
+ * его и обновляет кэш.
+ */
+SoundSamplesPtr decodeSound(
+    const std::shared_ptr<const ResourcePack> &pack,
+    const std::shared_ptr<const AssetCache> &cache,
+    const std::string &name)
+{
+    TRACE_SCOPE("decodeSound");
+    MappedFile file;
+    ResourcePack::Blob source;
+    if (!findSource(pack, name, file, source))
+    {
+        LOG_ERROR("Could not load resource \"" << name << "\".");
+        return nullptr;
+    }
+
+    const std::uint64_t sourceHash = AssetCache::hash(source.data, source.size);
+    if (SoundSamplesPtr sound = cache->loadSound(name, sourceHash))
+    {
+        return sound;
+    }
 
-const std::string SOUND_JUMP("jump.ogg");
-const std::string SOUND_LAND("land.ogg");
-const std::string SOUND_PUSH("push.ogg");
-const std::string SOUND_BLOW("blow.ogg");
-const std::string SOUND_SCORE("score.ogg");
-const std::string SOUND_GAME_OVER("game_over.ogg");
+    sf::InputSoundFile soundFile;
+    if (!soundFile.openFromMemory(source.data, source.size))
+    {
+        LOG_ERROR("Could not load resource \"" << name << "\".");
+        return nullptr;
+    }
+
+    std::shared_ptr<std::vector<sf::Int16>> samples =
+        std::make_shared<std::vector<sf::Int16>>(soundFile.getSampleCount());
+    samples->resize(soundFile.read(samples->data(), samples->size()));
+
+    std::shared_ptr<SoundSamples> sound = std::make_shared<SoundSamples>();
+    sound->samples = samples->data();
+    sound->samplesQuantity = samples->size();
+    sound->channelCount = soundFile.getChannelCount();
+    sound->sampleRate = soundFile.getSampleRate();
+    sound->storage = samples;
+    cache->storeSound(name, sourceHash, *sound);
+    return sound;
+}
+
+template<typename T>
+bool isReady(const std::shared_future<T> &future)
+{
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
 
 }
 
@@ -39,26 +176,161 @@ ResourceLoader& ResourceLoader::instance()
 }
 
 
+ResourceLoader::ResourceLoader() = default;
+
+
+ResourceLoader::~ResourceLoader() = default;
+
+
+void ResourceLoader::setResourcePack(const std::shared_ptr<const ResourcePack> &pack)
+{
+    m_resourcePack = pack;
+}
+
+
+bool ResourceLoader::openResourcePack(const std::filesystem::path &executablePath)
+{
+    const std::filesystem::path packPaths[] =
+    {
+        RESOURCE_PACK_FILE_NAME,
+        executablePath.parent_path() / RESOURCE_PACK_FILE_NAME
+    };
+    for (const std::filesystem::path &path : packPaths)
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(path, error))
+        {
+            continue;
+        }
+        std::shared_ptr<ResourcePack> pack = std::make_shared<ResourcePack>();
+        if (!pack->open(path))
+        {
+            return false;
+        }
+        setResourcePack(pack);
+        return true;
+    }
+    LOG_INFO("Resource pack " << RESOURCE_PACK_FILE_NAME << " not found, loading loose files.");
+    return true;
+}
+
+
 bool ResourceLoader::load()
 {
-    const bool result =
-        loadTexture(TextureId::Splash, TEXTURE_SPLASH) &&
-        loadTexture(TextureId::Box, TEXTURE_BOX) &&
-        loadTexture(TextureId::Player, TEXTURE_PLAYER) &&
-        loadTexture(TextureId::Background, TEXTURE_BACKGROUND) &&
-        loadTexture(TextureId::Foreground, TEXTURE_FOREGROUND) &&
-        loadTexture(TextureId::Crane, TEXTURE_CRANE) &&
-        loadTexture(TextureId::Font, TEXTURE_FONT) &&
-        loadTexture(TextureId::Frame, TEXTURE_FRAME) &&
-        loadTexture(TextureId::Hourglass, TEXTURE_HOURGLASS)
-        &&
-        loadSound(SoundId::Jump, SOUND_JUMP) &&
-        loadSound(SoundId::Land, SOUND_LAND) &&
-        loadSound(SoundId::Push, SOUND_PUSH) &&
-        loadSound(SoundId::Blow, SOUND_BLOW) &&
-        loadSound(SoundId::Score, SOUND_SCORE) &&
-        loadSound(SoundId::GameOver, SOUND_GAME_OVER);
-    return result;
+    startLoading();
+    for (const auto &decoded : m_decodedImages)
+    {
+        decoded.second.wait();
+    }
+    for (const auto &decoded : m_decodedSounds)
+    {
+        decoded.second.wait();
+    }
+    return update() && loaded();
+}
+
+
+bool ResourceLoader::loadImages()
+{
+    startLoading();
+    for (const auto &[id, decoded] : m_decodedImages)
+    {
+        const ImagePtr image = decoded.get();
+        if (image == nullptr)
+        {
+            return false;
+        }
+        m_images[id] = image;
+    }
+    return true;
+}
+
+
+bool ResourceLoader::loadImages(const std::filesystem::path &executablePath)
+{
+    return openResourcePack(executablePath) && loadImages();
+}
+
+
+void ResourceLoader::startLoading()
+{
+    if (m_threadPool != nullptr || loaded())
+    {
+        return;
+    }
+
+    LOG_DEBUG("Start loading resources.");
+    m_threadPool = std::make_unique<ThreadPool>(
+        std::min<std::size_t>(
+            std::max(1u, std::thread::hardware_concurrency()),
+            TEXTURE_FILES.size() + SOUND_FILES.size()));
+    // Задачи удерживают архив, чтобы отображение не закрылось
+    // до окончания декодирования.
+    const std::shared_ptr<const ResourcePack> pack = m_resourcePack;
+    const std::shared_ptr<const AssetCache> cache =
+        std::make_shared<AssetCache>(CACHE_DIR);
+    for (const auto &[id, name] : TEXTURE_FILES)
+    {
+        m_decodedImages[id] = m_threadPool->submit(
+            [pack, cache, name = name]() { return decodeImage(pack, cache, name); }).share();
+    }
+    for (const auto &[id, name] : SOUND_FILES)
+    {
+        m_decodedSounds[id] = m_threadPool->submit(
+            [pack, cache, name = name]() { return decodeSound(pack, cache, name); }).share();
+    }
+}
+
+
+bool ResourceLoader::update()
+{
+    TRACE_SCOPE("ResourceLoader::update");
+    // Создание текстур и буферов требует контекста, поэтому выполняется
+    // в потоке отрисовки для всех ресурсов, готовых к этому моменту.
+    for (const auto &[id, decoded] : m_decodedImages)
+    {
+        if (m_textures.count(id) == 0 && isReady(decoded) &&
+            !uploadTexture(id, decoded.get()))
+        {
+            return false;
+        }
+    }
+    for (const auto &[id, decoded] : m_decodedSounds)
+    {
+        if (m_sounds.count(id) == 0 && isReady(decoded) &&
+            !uploadSound(id, decoded.get()))
+        {
+            return false;
+        }
+    }
+
+    if (m_threadPool != nullptr && loaded())
+    {
+        LOG_DEBUG("All resources loaded.");
+        m_threadPool.reset();
+    }
+    return true;
+}
+
+
+bool ResourceLoader::loaded() const noexcept
+{
+    return m_textures.size() == TEXTURE_FILES.size() &&
+        m_sounds.size() == SOUND_FILES.size();
+}
+
+
+std::shared_future<ImagePtr> ResourceLoader::decodedImage(TextureId id) const
+{
+    const auto it = m_decodedImages.find(id);
+    return it != m_decodedImages.cend() ? it->second : std::shared_future<ImagePtr>();
+}
+
+
+std::shared_future<SoundSamplesPtr> ResourceLoader::decodedSound(SoundId id) const
+{
+    const auto it = m_decodedSounds.find(id);
+    return it != m_decodedSounds.cend() ? it->second : std::shared_future<SoundSamplesPtr>();
 }
 
 
@@ -74,6 +346,37 @@ TexturePtr ResourceLoader::texture(const TextureId &id) const noexcept
 }
 
 
+ImagePtr ResourceLoader::image(const TextureId &id) const noexcept
+{
+    const auto it = m_images.find(id);
+    if (it == m_images.cend())
+    {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+
+sf::Vector2u ResourceLoader::textureSize(const TextureId &id) const noexcept
+{
+    const ImagePtr image = this->image(id);
+    return image != nullptr ? image->getSize() : sf::Vector2u();
+}
+
+
+void ResourceLoader::applyTexture(sf::Sprite &sprite, const TextureId &id) const
+{
+    const TexturePtr texture = this->texture(id);
+    if (texture != nullptr)
+    {
+        sprite.setTexture(*texture);
+    }
+    const sf::Vector2u size = textureSize(id);
+    sprite.setTextureRect(sf::IntRect(0, 0, int(size.x), int(size.y)));
+}
+
+
 SoundBufferPtr ResourceLoader::sound(const SoundId &id) const noexcept
 {
     const auto it = m_sounds.find(id);
@@ -86,33 +389,40 @@ SoundBufferPtr ResourceLoader::sound(const SoundId &id) const noexcept
 }
 
 
-bool ResourceLoader::loadTexture(
-    const TextureId id,
-    const std::string &file)
+bool ResourceLoader::uploadTexture(TextureId id, const ImagePtr &image)
 {
+    if (image == nullptr)
+    {
+        return false;
+    }
     std::shared_ptr<sf::Texture> texture = std::make_shared<sf::Texture>();
-    const bool ok = texture->loadFromFile((PATH_GRAPHICS / file).string());
-    if (!ok)
+    if (!texture->loadFromImage(*image))
     {
-        LOG_ERROR("Could not load resource \"" << file << "\".");
+        LOG_ERROR("Could not create texture №" << unsigned(id) << ".");
         return false;
     }
+    m_images[id] = image;
     m_textures[id] = texture;
-    return ok;
+    return true;
 }
 
 
-bool ResourceLoader::loadSound(
-    const SoundId id,
-    const std::string &file)
+bool ResourceLoader::uploadSound(SoundId id, const SoundSamplesPtr &samples)
 {
+    if (samples == nullptr)
+    {
+        return false;
+    }
     std::shared_ptr<sf::SoundBuffer> soundBuffer = std::make_shared<sf::SoundBuffer>();
-    const bool ok = soundBuffer->loadFromFile((PATH_AUDIO / file).string());
-    if (!ok)
+    if (!soundBuffer->loadFromSamples(
+            samples->samples,
+            samples->samplesQuantity,
+            samples->channelCount,
+            samples->sampleRate))
     {
-        LOG_ERROR("Could not load resource \"" << file << "\".");
+        LOG_ERROR("Could not create sound buffer №" << unsigned(id) << ".");
         return false;
     }
     m_sounds[id] = soundBuffer;
-    return ok;
+    return true;
 }
@@ -0,0 +1,196 @@
+#include <game/resource_pack.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include <game/binary_io.h>
+#include <game/log.h>
+
+
+namespace
+{
+
+/// Сигнатура архива ресурсов.
+constexpr std::uint32_t RESOURCE_PACK_MAGIC = 0x4B504B53; // "SKPK"
+/// Версия формата архива ресурсов.
+constexpr std::uint32_t RESOURCE_PACK_VERSION = 1;
+/// Размер заголовка архива.
+constexpr std::size_t HEADER_SIZE = 12;
+/// Размер записи оглавления без имени.
+constexpr std::size_t ENTRY_SIZE = 18;
+
+const std::vector<std::string> PACKED_EXTENSIONS = { ".png", ".ogg" };
+
+
+std::uint64_t align(std::uint64_t offset)
+{
+    return (offset + RESOURCE_PACK_ALIGNMENT - 1)
+        / RESOURCE_PACK_ALIGNMENT * RESOURCE_PACK_ALIGNMENT;
+}
+
+}
+
+
+bool ResourcePack::open(const std::filesystem::path &path)
+{
+    if (!m_file.open(path))
+    {
+        return false;
+    }
+    if (!readIndex(m_file.data(), m_file.size()))
+    {
+        LOG_ERROR("Resource pack " << path << " is corrupted.");
+        m_file.close();
+        return false;
+    }
+    LOG_INFO("Resource pack " << path << " opened.");
+    return true;
+}
+
+
+bool ResourcePack::open(const std::uint8_t *data, std::size_t size)
+{
+    m_file.close();
+    if (!readIndex(data, size))
+    {
+        LOG_ERROR("Embedded resource pack is corrupted.");
+        return false;
+    }
+    return true;
+}
+
+
+const ResourcePack::Blob* ResourcePack::find(const std::string &name) const noexcept
+{
+    const auto it = m_entries.find(name);
+    return it != m_entries.cend() ? &it->second : nullptr;
+}
+
+
+bool ResourcePack::readIndex(const std::uint8_t *data, std::size_t size)
+{
+    m_entries.clear();
+
+    const std::uint8_t *cursor = data;
+    const std::uint8_t *end = data + size;
+    std::uint32_t magic{ 0 };
+    std::uint32_t version{ 0 };
+    std::uint32_t entriesQuantity{ 0 };
+    if (!readLittleEndian(cursor, end, magic) ||
+        !readLittleEndian(cursor, end, version) ||
+        !readLittleEndian(cursor, end, entriesQuantity) ||
+        magic != RESOURCE_PACK_MAGIC ||
+        version != RESOURCE_PACK_VERSION)
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < entriesQuantity; ++i)
+    {
+        std::uint64_t offset{ 0 };
+        std::uint64_t blobSize{ 0 };
+        std::uint16_t nameLength{ 0 };
+        if (!readLittleEndian(cursor, end, offset) ||
+            !readLittleEndian(cursor, end, blobSize) ||
+            !readLittleEndian(cursor, end, nameLength) ||
+            std::size_t(end - cursor) < nameLength ||
+            offset > size ||
+            blobSize > size - offset)
+        {
+            m_entries.clear();
+            return false;
+        }
+        const std::string name(reinterpret_cast<const char*>(cursor), nameLength);
+        cursor += nameLength;
+        m_entries[name] = Blob{ data + offset, std::size_t(blobSize) };
+    }
+    return true;
+}
+
+
+bool writeResourcePack(
+    const std::filesystem::path &directory,
+    const std::filesystem::path &path)
+{
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const auto &entry :
+        std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        const std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() &&
+            std::find(PACKED_EXTENSIONS.cbegin(), PACKED_EXTENSIONS.cend(), extension) !=
+                PACKED_EXTENSIONS.cend())
+        {
+            files.push_back(entry.path());
+        }
+    }
+    if (error)
+    {
+        LOG_ERROR("Failed to list directory " << directory << ": " << error.message() << ".");
+        return false;
+    }
+    // Порядок записей не должен зависеть от файловой системы.
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::string> names;
+    std::vector<std::uint64_t> sizes;
+    std::uint64_t offset = HEADER_SIZE;
+    for (const std::filesystem::path &file : files)
+    {
+        names.push_back(file.lexically_relative(directory).generic_string());
+        sizes.push_back(std::filesystem::file_size(file, error));
+        if (error)
+        {
+            LOG_ERROR("Failed to get size of file " << file << ".");
+            return false;
+        }
+        offset += ENTRY_SIZE + names.back().size();
+    }
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        LOG_ERROR("Failed to open resource pack " << path << " for writing.");
+        return false;
+    }
+
+    BinaryWriter writer(stream);
+    writer.write(RESOURCE_PACK_MAGIC);
+    writer.write(RESOURCE_PACK_VERSION);
+    writer.write(std::uint32_t(files.size()));
+    std::vector<std::uint64_t> offsets;
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        offset = align(offset);
+        offsets.push_back(offset);
+        writer.write(offset);
+        writer.write(sizes[i]);
+        writer.write(std::uint16_t(names[i].size()));
+        stream.write(names[i].data(), std::streamsize(names[i].size()));
+        offset += sizes[i];
+    }
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        const std::uint64_t position = std::uint64_t(stream.tellp());
+        const std::string padding(offsets[i] - position, '\0');
+        stream.write(padding.data(), std::streamsize(padding.size()));
+
+        std::ifstream file(files[i], std::ios::binary);
+        if (!file || !(stream << file.rdbuf()))
+        {
+            LOG_ERROR("Failed to pack file " << files[i] << ".");
+            return false;
+        }
+    }
+
+    if (!stream.flush())
+    {
+        LOG_ERROR("Failed to write resource pack " << path << ".");
+        return false;
+    }
+    LOG_INFO("Packed " << files.size() << " files into " << path << ".");
+    return true;
+}
@@ -1,8 +1,14 @@
 #include <game/screen_debug.h>
 
+#include <algorithm>
+#include <iomanip>
 #include <sstream>
 
+#include <game/allocation_tracker.h>
 #include <game/log.h>
+#include <game/performance_counters.h>
+#include <game/sound_system.h>
+#include <game/window.h>
 
 
 namespace
@@ -16,6 +22,52 @@ const sf::Color FONT_OUTLINE_COLOR(sf::Color::White);
 constexpr unsigned int FONT_SIZE = 14;
 constexpr unsigned int FONT_OUTLINE_THICKNESS = 2;
 
+#ifdef PROFILER_ENABLED
+const sf::Color GRAPH_COLOR(sf::Color::Blue);
+const sf::Color GRAPH_BUDGET_COLOR(sf::Color::Red);
+/// Расстояние между текстом и графиком.
+constexpr float GRAPH_MARGIN = 8;
+/// Ширина кадра на графике.
+constexpr float GRAPH_STEP = 2;
+constexpr float GRAPH_HEIGHT = 60;
+/// Длительность кадра, соответствующая высоте графика, секунды.
+constexpr double GRAPH_RANGE = 2.0 / FPS_LIMIT;
+
+
+void writeStatistics(
+    std::ostream &stream,
+    const std::string &name,
+    const Profiler::Statistics &statistics)
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    stream << ' ' << std::left << std::setw(16) << name << std::right
+        << std::setw(6) << Milliseconds(statistics.average).count() << " / "
+        << std::setw(6) << Milliseconds(statistics.p99).count();
+    if (AllocationTracker::enabled())
+    {
+        stream << std::setw(8) << statistics.allocations
+            << std::setw(10) << statistics.bytes;
+    }
+    stream << std::endl;
+}
+
+
+void writeCounters(
+    std::ostream &stream,
+    const std::string &name,
+    const Profiler::Statistics &statistics)
+{
+    const double ipc = statistics.cycles > 0
+        ? statistics.instructions / statistics.cycles
+        : 0;
+    stream << ' ' << std::left << std::setw(16) << name << std::right
+        << std::setw(6) << ipc
+        << std::setw(10) << std::int64_t(statistics.cacheMisses)
+        << std::setw(10) << std::int64_t(statistics.branchMisses)
+        << std::endl;
+}
+#endif
+
 }
 
 
@@ -50,8 +102,19 @@ void ScreenDebug::update(const Duration&)
         ss << std::endl;
     }
     ss << "God mode (G): " << m_world->m_godMode << std::endl;
+    const SoundSystem::Statistics sound = SoundSystem::instance().statistics();
+    ss << "Sound latency, ms: "
+        << sound.averageLatency.count() * 1000 << " avg, "
+        << sound.maximumLatency.count() * 1000 << " max, "
+        << sound.droppedEvents << " dropped" << std::endl;
+#ifdef PROFILER_ENABLED
+    writeProfile(ss);
+#endif
 
     m_text->setString(ss.str());
+#ifdef PROFILER_ENABLED
+    updateGraph();
+#endif
 }
 
 
@@ -64,6 +127,10 @@ bool ScreenDebug::handleKeyPressed(const sf::Keyboard::Key)
 void ScreenDebug::draw(sf::RenderTarget &target, sf::RenderStates) const
 {
     target.draw(*m_text);
+#ifdef PROFILER_ENABLED
+    target.draw(m_graphBudget);
+    target.draw(m_graph);
+#endif
 }
 
 
@@ -84,3 +151,70 @@ void ScreenDebug::setup()
     m_text->setOutlineColor(FONT_OUTLINE_COLOR);
     m_text->setOutlineThickness(FONT_OUTLINE_THICKNESS);
 }
+
+
+#ifdef PROFILER_ENABLED
+void ScreenDebug::writeProfile(std::ostream &stream) const
+{
+    const Profiler &profiler = Profiler::instance();
+    stream << "Profile, ms (avg / p99)";
+    if (AllocationTracker::enabled())
+    {
+        stream << ", allocs and bytes per frame";
+    }
+    stream << ':' << std::endl << std::fixed << std::setprecision(2);
+    writeStatistics(stream, "Frame", profiler.frameStatistics());
+    for (std::size_t i = 0; i < Profiler::ZONES_QUANTITY; ++i)
+    {
+        writeStatistics(
+            stream,
+            Profiler::ZONE_NAMES[i],
+            profiler.statistics(Profiler::Zone(i)));
+    }
+
+    if (!PerformanceCounters::thread().opened())
+    {
+        return;
+    }
+    stream << "Counters (IPC, cache and branch misses per frame):" << std::endl;
+    writeCounters(stream, "Frame", profiler.frameStatistics());
+    for (std::size_t i = 0; i < Profiler::ZONES_QUANTITY; ++i)
+    {
+        writeCounters(
+            stream,
+            Profiler::ZONE_NAMES[i],
+            profiler.statistics(Profiler::Zone(i)));
+    }
+}
+
+
+void ScreenDebug::updateGraph()
+{
+    const sf::FloatRect bounds = m_text->getGlobalBounds();
+    const float left = bounds.left;
+    const float bottom = bounds.top + bounds.height + GRAPH_MARGIN + GRAPH_HEIGHT;
+
+    const float budgetY = bottom - GRAPH_HEIGHT * float((1.0 / FPS_LIMIT) / GRAPH_RANGE);
+    m_graphBudget.setPrimitiveType(sf::Lines);
+    m_graphBudget.resize(2);
+    m_graphBudget[0] = sf::Vertex(sf::Vector2f(left, budgetY), GRAPH_BUDGET_COLOR);
+    m_graphBudget[1] = sf::Vertex(
+        sf::Vector2f(left + GRAPH_STEP * PROFILER_HISTORY_SIZE, budgetY),
+        GRAPH_BUDGET_COLOR);
+
+    const Profiler &profiler = Profiler::instance();
+    const Profiler::History history = profiler.frameHistory();
+    const std::size_t size = profiler.historySize();
+    m_graph.setPrimitiveType(sf::LineStrip);
+    m_graph.resize(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const double seconds = std::chrono::duration<double>(
+            std::chrono::nanoseconds(history[i])).count();
+        const float height = GRAPH_HEIGHT * float(std::min(seconds / GRAPH_RANGE, 1.0));
+        m_graph[i] = sf::Vertex(
+            sf::Vector2f(left + GRAPH_STEP * float(i), bottom - height),
+            GRAPH_COLOR);
+    }
+}
+#endif
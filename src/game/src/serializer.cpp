@@ -1,55 +1,161 @@
 #include <game/serializer.h>
 
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string_view>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 
+#include <game/atomic_file.h>
 #include <game/config.h>
 #include <game/log.h>
 #include <game/version/version.h>
 
 
-using Node = boost::property_tree::ptree;
-
-
 namespace
 {
 
 const std::filesystem::path CONFIG_FILE_NAME = "config.xml";
+const std::string INDENT = "  ";
 const std::string ATTRIBUTE_VERSION = "Version";
 const std::string TAG_CONFIG = "Config";
 const std::string TAG_CRANES_QUANTITY = "CranesQuantity";
 const std::string TAG_SOUND = "Sound";
-const std::string TAG_HIGH_SCORE = "HighScore";
+/// Рекорд, хранившийся в настройках до появления таблицы рекордов.
+const std::string TAG_LEGACY_HIGH_SCORE = "HighScore";
+const std::string TAG_SCREEN_SCALE = "ScreenScale";
+const std::string TAG_RECORD_REPLAYS = "RecordReplays";
 
 
-bool writeFile(
-    const std::filesystem::path &fileName,
-    const Node &tree)
+/// Удаляет пробельные символы в начале и в конце строки.
+std::string_view trim(std::string_view text)
 {
-    namespace pt = boost::property_tree;
+    const std::size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string_view::npos)
+    {
+        return std::string_view();
+    }
+    const std::size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
 
-    const pt::xml_writer_settings<Node::key_type> indent =
-        pt::xml_writer_make_settings<Node::key_type>(' ', 2);
+/*!
+ * Находит содержимое элемента вида <tag>value</tag>.
+ * \param[in] text Текст XML.
+ * \param[in] tag Название элемента.
+ * \return Содержимое элемента, если элемент найден.
+ */
+std::optional<std::string_view> findElement(
+    std::string_view text,
+    const std::string &tag)
+{
+    const std::string opening = '<' + tag + '>';
+    const std::string closing = "</" + tag + '>';
+    const std::size_t begin = text.find(opening);
+    if (begin == std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+    const std::size_t valueBegin = begin + opening.size();
+    const std::size_t end = text.find(closing, valueBegin);
+    if (end == std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+    return trim(text.substr(valueBegin, end - valueBegin));
+}
 
-    try
+bool parseValue(std::string_view text, bool &value)
+{
+    if (text == "true" || text == "1")
     {
-        pt::write_xml(fileName.string(), tree, std::locale(), indent);
+        value = true;
+        return true;
     }
-    catch (const pt::xml_parser_error &error)
+    if (text == "false" || text == "0")
+    {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+bool parseValue(std::string_view text, unsigned int &value)
+{
+    const char *end = text.data() + text.size();
+    const std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+template<typename T>
+bool parseElement(std::string_view text, const std::string &tag, T &value)
+{
+    const std::optional<std::string_view> element = findElement(text, tag);
+    return element.has_value() && parseValue(element.value(), value);
+}
+
+/*!
+ * Быстрый разбор файла настроек известной структуры без построения
+ * дерева документа. Файлы, записанные этой программой, разбираются
+ * полностью; для остальных используется разбор boost::property_tree.
+ * \param[in] text Содержимое файла.
+ * \param[out] values Прочитанные настройки.
+ * \param[out] legacyHighScore Рекорд из настроек прежних версий, если есть.
+ * \return \c false, если структура файла отличается от ожидаемой.
+ */
+bool parseFast(
+    std::string_view text,
+    Config::Values &values,
+    std::optional<unsigned int> &legacyHighScore)
+{
+    const std::string rootTag = '<' + ProjectName + ' ';
+    const std::size_t root = text.find(rootTag);
+    if (root == std::string_view::npos ||
+        !findElement(text, TAG_CONFIG).has_value())
     {
-        LOG_ERROR("Failed to write configuration: " << error.message());
         return false;
     }
 
-    LOG_INFO("Configuration has been written.");
+    unsigned int cranesQuantity = 0;
+    if (!parseElement(text, TAG_CRANES_QUANTITY, cranesQuantity) ||
+        !parseElement(text, TAG_SOUND, values.sound) ||
+        !parseElement(text, TAG_SCREEN_SCALE, values.screenScale) ||
+        !parseElement(text, TAG_RECORD_REPLAYS, values.recordReplays))
+    {
+        return false;
+    }
+    values.cranesQuantity = std::uint8_t(std::clamp(
+        cranesQuantity,
+        1u,
+        unsigned(MAX_INITIAL_CRANES_QUANTITY)));
+    unsigned int highScore = 0;
+    if (parseElement(text, TAG_LEGACY_HIGH_SCORE, highScore))
+    {
+        legacyHighScore = highScore;
+    }
+
+    const std::string versionPrefix = ATTRIBUTE_VERSION + "=\"";
+    const std::size_t rootEnd = text.find('>', root);
+    const std::size_t version = text.substr(0, rootEnd).find(versionPrefix, root);
+    const std::size_t versionBegin = version + versionPrefix.size();
+    LOG_INFO(
+        "Configuration version: "
+        << (version == std::string_view::npos
+            ? std::string_view("Unknown version")
+            : text.substr(versionBegin, text.find('"', versionBegin) - versionBegin))
+        << '.');
     return true;
 }
 
 void parseNodeConfig(
     const boost::property_tree::ptree::value_type &node,
-    Config &config)
+    Config::Values &config,
+    std::optional<unsigned int> &legacyHighScore)
 {
     namespace pt = boost::property_tree;
     pt::ptree tree;
@@ -57,31 +163,40 @@ void parseNodeConfig(
     {
         if (subNode.first == TAG_CRANES_QUANTITY)
         {
-            config.cranesQuantity = subNode.second.get<std::uint8_t>("");
-            config.cranesQuantity = std::clamp(
-                config.cranesQuantity,
-                std::uint8_t(1),
-                MAX_INITIAL_CRANES_QUANTITY);
+            config.cranesQuantity = std::uint8_t(std::clamp(
+                subNode.second.get<unsigned int>(""),
+                1u,
+                unsigned(MAX_INITIAL_CRANES_QUANTITY)));
         }
         if (subNode.first == TAG_SOUND)
         {
             config.sound = subNode.second.get<bool>("");
         }
-        if (subNode.first == TAG_HIGH_SCORE)
+        if (subNode.first == TAG_LEGACY_HIGH_SCORE)
+        {
+            legacyHighScore = subNode.second.get<unsigned int>("");
+        }
+        if (subNode.first == TAG_SCREEN_SCALE)
         {
-            config.highScore = subNode.second.get<unsigned int>("");
+            config.screenScale = subNode.second.get<unsigned int>("");
+        }
+        if (subNode.first == TAG_RECORD_REPLAYS)
+        {
+            config.recordReplays = subNode.second.get<bool>("");
         }
     }
 }
 
-void parseFile(
-    const std::filesystem::path &path,
-    Config &config)
+void parseTree(
+    const std::string &text,
+    Config::Values &config,
+    std::optional<unsigned int> &legacyHighScore)
 {
     namespace pt = boost::property_tree;
     pt::ptree tree;
 
-    pt::read_xml(path.string(), tree, pt::xml_parser::no_comments);
+    std::istringstream stream(text);
+    pt::read_xml(stream, tree, pt::xml_parser::no_comments);
     for (const pt::ptree::value_type &node : tree)
     {
         if (node.first != ProjectName)
@@ -100,7 +215,7 @@ void parseFile(
             {
                 continue;
             }
-            parseNodeConfig(nodeConfig, config);
+            parseNodeConfig(nodeConfig, config, legacyHighScore);
         }
     }
 }
@@ -108,48 +223,85 @@ void parseFile(
 }
 
 
-bool writeConfig()
+bool writeConfig(const Config::Values &values)
 {
     const std::filesystem::path &path = CONFIG_FILE_NAME;
     LOG_INFO("Writing configuration into " << path << ".");
 
-    const Config &config = Config::instance();
-
-    Node tree;
-
-    Node &nodeRoot = tree.add_child(ProjectName, Node());
-    nodeRoot.put("<xmlattr>." + ATTRIBUTE_VERSION, ProjectVersionMajorMinor);
+    // Структура файла фиксирована, поэтому он формируется напрямую,
+    // в том же виде, в каком его записывал boost::property_tree.
+    std::ostringstream text;
+    text << std::boolalpha
+        << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        << '<' << ProjectName << ' ' << ATTRIBUTE_VERSION
+        << "=\"" << ProjectVersionMajorMinor << "\">\n"
+        << INDENT << '<' << TAG_CONFIG << ">\n";
+    const auto writeElement = [&text](const std::string &tag, const auto &value)
+    {
+        text << INDENT << INDENT
+            << '<' << tag << '>' << value << "</" << tag << ">\n";
+    };
+    writeElement(TAG_CRANES_QUANTITY, unsigned(values.cranesQuantity));
+    writeElement(TAG_SOUND, values.sound);
+    writeElement(TAG_SCREEN_SCALE, values.screenScale);
+    writeElement(TAG_RECORD_REPLAYS, values.recordReplays);
+    text << INDENT << "</" << TAG_CONFIG << ">\n"
+        << "</" << ProjectName << ">\n";
 
-    Node &nodeConfig = nodeRoot.add_child(TAG_CONFIG, Node());
-    nodeConfig.add(TAG_CRANES_QUANTITY, config.cranesQuantity);
-    nodeConfig.add(TAG_SOUND, config.sound);
-    nodeConfig.add(TAG_HIGH_SCORE, config.highScore);
+    if (!writeFileAtomically(path, text.str()))
+    {
+        LOG_ERROR("Failed to write configuration into " << path << ".");
+        return false;
+    }
 
-    return writeFile(path, tree);
+    LOG_INFO("Configuration has been written.");
+    return true;
 }
 
 
-bool readConfig()
+bool readConfig(std::optional<unsigned int> &legacyHighScore)
 {
     const std::filesystem::path &path = CONFIG_FILE_NAME;
     LOG_INFO("Reading configuration from " << path << ".");
 
-    Config &config = Config::instance();
-    try
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
     {
-        parseFile(path, config);
+        LOG_ERROR("Failed to read configuration: cannot open " << path << ".");
+        return false;
     }
-    catch (const std::exception &exception)
+    const std::string text(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    Config::Values values;
+    legacyHighScore = std::nullopt;
+    if (!parseFast(text, values, legacyHighScore))
     {
-        LOG_ERROR("Failed to read configuration: " << exception.what() << ".")
-        return false;
+        LOG_DEBUG("Configuration has unexpected structure, using XML parser.");
+        values = Config::Values();
+        legacyHighScore = std::nullopt;
+        try
+        {
+            parseTree(text, values, legacyHighScore);
+        }
+        catch (const std::exception &exception)
+        {
+            LOG_ERROR("Failed to read configuration: " << exception.what() << ".")
+            return false;
+        }
     }
 
+    Config &config = Config::instance();
+    config.setValues(values);
+    config.setDirty(false);
+
     LOG_INFO(
         "Configuration has been read:" << std::endl
-        << "  cranes quantity: " << unsigned(config.cranesQuantity) << std::endl
-        << "  sound: " << config.sound << std::endl
-        << "  highScore: " << config.highScore);
+        << "  cranes quantity: " << unsigned(values.cranesQuantity) << std::endl
+        << "  sound: " << values.sound << std::endl
+        << "  screenScale: " << values.screenScale << std::endl
+        << "  recordReplays: " << values.recordReplays);
 
     return true;
 }
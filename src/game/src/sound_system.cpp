@@ -1,6 +1,25 @@
 #include <game/sound_system.h>
 
 #include <game/config.h>
+#include <game/tracer.h>
+
+
+namespace
+{
+
+/// Приоритеты звуков. Звук с большим приоритетом может прервать звук
+/// с меньшим или равным приоритетом.
+constexpr std::array<std::uint8_t, SOUNDS_QUANTITY> PRIORITIES =
+{
+    1, // Jump
+    0, // Land
+    1, // Push
+    2, // Blow
+    3, // Score
+    4 // GameOver
+};
+
+}
 
 
 SoundSystem& SoundSystem::instance()
@@ -16,16 +35,51 @@ void SoundSystem::setEnabled(bool value)
 }
 
 
+void SoundSystem::update()
+{
+    ++m_frame;
+    if (!m_thread.joinable() && m_resourceLoader.loaded())
+    {
+        // Голоса закрепляются до запуска потока, после чего
+        // к ним обращается только поток воспроизведения.
+        bindVoices();
+        m_thread = std::thread(&SoundSystem::run, this);
+    }
+}
+
+
 void SoundSystem::playSound(ResourceLoader::SoundId id)
 {
-    if (!m_enabled)
+    if (!m_enabled || !m_thread.joinable())
     {
         return;
     }
+    if (!m_events.push(Event{ id, m_frame, Clock::now() }))
+    {
+        m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pushedQuantity;
+    }
+    m_condition.notify_one();
+}
+
 
-    // TODO: Сделать параллельное воспроизведение звуков?
-    m_sound.setBuffer(*m_resourceLoader.sound(id));
-    m_sound.play();
+SoundSystem::Statistics SoundSystem::statistics() const noexcept
+{
+    Statistics result;
+    const std::uint64_t quantity = m_eventsQuantity.load(std::memory_order_relaxed);
+    if (quantity != 0)
+    {
+        result.averageLatency = std::chrono::nanoseconds(
+            m_latencySum.load(std::memory_order_relaxed) / quantity);
+    }
+    result.maximumLatency = std::chrono::nanoseconds(
+        m_latencyMaximum.load(std::memory_order_relaxed));
+    result.droppedEvents = m_droppedEvents.load(std::memory_order_relaxed);
+    return result;
 }
 
 
@@ -36,7 +90,146 @@ SoundSystem::SoundSystem()
 }
 
 
+SoundSystem::~SoundSystem()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_one();
+        m_thread.join();
+    }
+}
+
+
 void SoundSystem::setup()
 {
-    setEnabled(Config::instance().sound);
+    setEnabled(Config::instance().sound());
+}
+
+
+void SoundSystem::run()
+{
+    Tracer::instance().setThreadName("sound");
+    Event event;
+    std::uint64_t poppedQuantity = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(
+                lock,
+                [this, poppedQuantity]()
+                {
+                    return m_stopping || m_pushedQuantity != poppedQuantity;
+                });
+            if (m_stopping)
+            {
+                return;
+            }
+        }
+        while (m_events.pop(event))
+        {
+            ++poppedQuantity;
+            trigger(event);
+        }
+    }
+}
+
+
+void SoundSystem::trigger(const Event &event)
+{
+    TRACE_SCOPE("SoundSystem::trigger");
+    const std::uint64_t latency = std::uint64_t(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - event.time).count());
+    m_latencySum.fetch_add(latency, std::memory_order_relaxed);
+    m_eventsQuantity.fetch_add(1, std::memory_order_relaxed);
+    if (latency > m_latencyMaximum.load(std::memory_order_relaxed))
+    {
+        m_latencyMaximum.store(latency, std::memory_order_relaxed);
+    }
+
+    const std::size_t index = std::size_t(event.id);
+    if (m_triggerFrames[index] == event.frame)
+    {
+        return;
+    }
+    m_triggerFrames[index] = event.frame;
+
+    // Свободный голос звука либо самый давно запущенный.
+    Voice *voice = &m_voices[index].front();
+    for (Voice &candidate : m_voices[index])
+    {
+        if (candidate.sound.getStatus() != sf::Sound::Playing)
+        {
+            voice = &candidate;
+            break;
+        }
+        if (candidate.startIndex < voice->startIndex)
+        {
+            voice = &candidate;
+        }
+    }
+
+    if (voice->sound.getStatus() != sf::Sound::Playing &&
+        !reserveVoice(PRIORITIES[index]))
+    {
+        return;
+    }
+    voice->startIndex = ++m_startIndex;
+    voice->sound.play();
+}
+
+
+void SoundSystem::bindVoices()
+{
+    for (std::size_t i = 0; i < SOUNDS_QUANTITY; ++i)
+    {
+        const SoundBufferPtr buffer =
+            m_resourceLoader.sound(ResourceLoader::SoundId(i));
+        for (Voice &voice : m_voices[i])
+        {
+            voice.sound.setBuffer(*buffer);
+        }
+    }
+}
+
+
+bool SoundSystem::reserveVoice(std::uint8_t priority)
+{
+    std::size_t playingQuantity = 0;
+    Voice *victim = nullptr;
+    std::uint8_t victimPriority = 0;
+    for (std::size_t i = 0; i < SOUNDS_QUANTITY; ++i)
+    {
+        for (Voice &voice : m_voices[i])
+        {
+            if (voice.sound.getStatus() != sf::Sound::Playing)
+            {
+                continue;
+            }
+            ++playingQuantity;
+            if (victim == nullptr ||
+                PRIORITIES[i] < victimPriority ||
+                (PRIORITIES[i] == victimPriority && voice.startIndex < victim->startIndex))
+            {
+                victim = &voice;
+                victimPriority = PRIORITIES[i];
+            }
+        }
+    }
+
+    if (playingQuantity < MAX_PLAYING_VOICES)
+    {
+        return true;
+    }
+    if (victimPriority > priority)
+    {
+        return false;
+    }
+    victim->sound.stop();
+    return true;
 }
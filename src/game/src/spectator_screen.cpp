@@ -0,0 +1,123 @@
+#include <game/spectator_screen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <game/consts.h>
+#include <game/log.h>
+
+
+namespace
+{
+
+constexpr sf::Keyboard::Key KEY_BACK = sf::Keyboard::Key::Escape;
+
+/// Время, в течение которого отображается законченная игра,
+/// прежде чем в ячейке начнётся новая.
+const Duration RESTART_DELAY(3);
+/// Начало имени бота в таблице рекордов, за которым следует номер ячейки.
+const std::string BOT_NAME_PREFIX = "Бот ";
+
+
+std::size_t columnsQuantity(std::size_t worldsQuantity)
+{
+    return std::max<std::size_t>(
+        1,
+        std::size_t(std::ceil(std::sqrt(double(worldsQuantity)))));
+}
+
+}
+
+
+sf::Vector2u SpectatorScreen::frameSize(std::size_t worldsQuantity) noexcept
+{
+    const std::size_t columns = columnsQuantity(worldsQuantity);
+    const std::size_t rows = std::max<std::size_t>(
+        1,
+        (worldsQuantity + columns - 1) / columns);
+    return sf::Vector2u(SCREEN_SIZE.x * columns, SCREEN_SIZE.y * rows);
+}
+
+
+SpectatorScreen::SpectatorScreen(std::size_t worldsQuantity)
+{
+    setup(worldsQuantity);
+}
+
+
+void SpectatorScreen::update(const Duration &elapsed)
+{
+    for (Tile &tile : m_tiles)
+    {
+        if (tile.gameOverElapsed.has_value())
+        {
+            tile.gameOverElapsed = tile.gameOverElapsed.value() + elapsed;
+            if (tile.gameOverElapsed.value() >= RESTART_DELAY)
+            {
+                tile.gameOverElapsed = std::nullopt;
+                tile.world->start();
+            }
+        }
+        else
+        {
+            tile.bot.update(*tile.world, elapsed);
+        }
+        tile.world->update(elapsed);
+    }
+}
+
+
+bool SpectatorScreen::handleKeyPressed(const sf::Keyboard::Key key)
+{
+    if (key == KEY_BACK)
+    {
+        m_signalClose();
+        return true;
+    }
+    return false;
+}
+
+
+void SpectatorScreen::draw(sf::RenderTarget &target, sf::RenderStates states) const
+{
+    m_batch.clear();
+    for (std::size_t i = 0; i < m_tiles.size(); ++i)
+    {
+        m_batch.setOffset(sf::Vector2f(
+            float((i % m_columns) * SCREEN_SIZE.x),
+            float((i / m_columns) * SCREEN_SIZE.y)));
+        m_tiles[i].world->drawSprites(m_batch);
+    }
+    target.draw(m_batch, states);
+}
+
+
+boost::signals2::connection SpectatorScreen::connectClose(const Slot &slot)
+{
+    return m_signalClose.connect(slot);
+}
+
+
+void SpectatorScreen::setup(std::size_t worldsQuantity)
+{
+    m_columns = columnsQuantity(worldsQuantity);
+
+    std::random_device device;
+    m_tiles.reserve(worldsQuantity);
+    for (std::size_t i = 0; i < worldsQuantity; ++i)
+    {
+        m_tiles.push_back(Tile{ std::make_unique<World>(), RandomBot(device()), std::nullopt });
+        World &world = *m_tiles.back().world;
+        // Результаты ботов не смешиваются с результатами игрока.
+        world.setPlayerName(
+            BOT_NAME_PREFIX + std::to_string(i + 1),
+            Leaderboard::Board::Bots);
+        world.connectGameOver(
+            [this, i]() { m_tiles[i].gameOverElapsed = Duration(); });
+        world.start();
+    }
+    LOG_INFO(
+        "Spectating " << worldsQuantity << " worlds in "
+        << m_columns << " columns.");
+}
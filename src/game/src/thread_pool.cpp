@@ -0,0 +1,62 @@
+#include <game/thread_pool.h>
+
+#include <algorithm>
+
+#include <game/tracer.h>
+
+
+ThreadPool::ThreadPool(std::size_t threadsQuantity)
+{
+    if (threadsQuantity == 0)
+    {
+        threadsQuantity = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_threads.reserve(threadsQuantity);
+    for (std::size_t i = 0; i < threadsQuantity; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (std::thread &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+
+std::size_t ThreadPool::threadsQuantity() const noexcept
+{
+    return m_threads.size();
+}
+
+
+void ThreadPool::run()
+{
+    Tracer::instance().setThreadName("thread pool");
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(
+                lock,
+                [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,218 @@
+#include <game/tracer.h>
+
+#include <fstream>
+
+#include <game/log.h>
+
+
+namespace
+{
+
+/// Идентификатор процесса в трассе.
+constexpr int TRACE_PID = 1;
+
+
+void writeString(std::ostream &stream, const char *string)
+{
+    stream << '"';
+    for (; *string != '\0'; ++string)
+    {
+        if (*string == '"' || *string == '\\')
+        {
+            stream << '\\';
+        }
+        stream << *string;
+    }
+    stream << '"';
+}
+
+}
+
+
+/// Буфер событий одного потока.
+class Tracer::ThreadBuffer final
+{
+public:
+    using Block = std::array<Event, TRACE_BLOCK_EVENTS>;
+
+public:
+    explicit ThreadBuffer(std::size_t id)
+        : m_id(id)
+    {
+    }
+
+    std::size_t id() const noexcept
+    {
+        return m_id;
+    }
+
+    const char* name() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_name;
+    }
+
+    void setName(const char *name)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_name = name;
+    }
+
+    void push(const Event &event)
+    {
+        // Блокировка захватывается другим потоком только на время
+        // копирования событий при записи трассы.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_blocks.empty() || m_lastBlockSize == TRACE_BLOCK_EVENTS)
+        {
+            m_blocks.push_back(std::make_unique<Block>());
+            m_lastBlockSize = 0;
+        }
+        (*m_blocks.back())[m_lastBlockSize++] = event;
+    }
+
+    std::vector<Event> events() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<Event> result;
+        if (m_blocks.empty())
+        {
+            return result;
+        }
+        result.reserve((m_blocks.size() - 1) * TRACE_BLOCK_EVENTS + m_lastBlockSize);
+        for (std::size_t i = 0; i < m_blocks.size(); ++i)
+        {
+            const std::size_t size = i + 1 < m_blocks.size()
+                ? TRACE_BLOCK_EVENTS
+                : m_lastBlockSize;
+            result.insert(result.end(), m_blocks[i]->cbegin(), m_blocks[i]->cbegin() + size);
+        }
+        return result;
+    }
+
+private:
+    const std::size_t m_id;
+    mutable std::mutex m_mutex;
+    const char *m_name{ nullptr };
+    std::vector<std::unique_ptr<Block>> m_blocks;
+    std::size_t m_lastBlockSize{ 0 };
+};
+
+
+Tracer& Tracer::instance()
+{
+    static Tracer singleton;
+    return singleton;
+}
+
+
+bool Tracer::open(const std::filesystem::path &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!std::ofstream(path, std::ios::trunc))
+    {
+        LOG_ERROR("Failed to open trace " << path << ".");
+        return false;
+    }
+
+    LOG_INFO("Writing trace to " << path << ".");
+    m_path = path;
+    m_start = Clock::now();
+    m_enabled = true;
+    return true;
+}
+
+
+void Tracer::close()
+{
+    if (!enabled())
+    {
+        return;
+    }
+    write();
+    m_enabled = false;
+}
+
+
+bool Tracer::write()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_path.empty())
+    {
+        return false;
+    }
+
+    std::ofstream file(m_path, std::ios::trunc);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::size_t quantity = 0;
+    for (const std::shared_ptr<ThreadBuffer> &buffer : m_buffers)
+    {
+        const char *name = buffer->name();
+        if (name != nullptr)
+        {
+            file << (first ? "\n" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << TRACE_PID
+                << ",\"tid\":" << buffer->id() << ",\"args\":{\"name\":";
+            writeString(file, name);
+            file << "}}";
+            first = false;
+        }
+
+        for (const Event &event : buffer->events())
+        {
+            // Время в микросекундах с точностью до наносекунды.
+            file << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(file, event.name);
+            file << ",\"ph\":\"" << event.phase
+                << "\",\"ts\":" << event.time / 1000 << '.'
+                << char('0' + event.time / 100 % 10)
+                << char('0' + event.time / 10 % 10)
+                << char('0' + event.time % 10)
+                << ",\"pid\":" << TRACE_PID
+                << ",\"tid\":" << buffer->id() << '}';
+            first = false;
+            ++quantity;
+        }
+    }
+    file << "\n]}\n";
+    file.close();
+    if (!file)
+    {
+        LOG_ERROR("Failed to write trace " << m_path << ".");
+        return false;
+    }
+    LOG_INFO("Trace of " << quantity << " events has been written to " << m_path << ".");
+    return true;
+}
+
+
+void Tracer::setThreadName(const char *name)
+{
+    if (!enabled())
+    {
+        return;
+    }
+    threadBuffer().setName(name);
+}
+
+
+Tracer::ThreadBuffer& Tracer::threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (buffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buffer = std::make_shared<ThreadBuffer>(m_buffers.size() + 1);
+        m_buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+
+void Tracer::append(const char *name, char phase)
+{
+    const std::int64_t time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count();
+    threadBuffer().push(Event{ name, time, phase });
+}
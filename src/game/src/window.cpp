@@ -1,16 +1,36 @@
 #include <game/window.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <game/consts.h>
+#include <game/log.h>
+#include <game/profiler.h>
+#include <game/tracer.h>
 
 
 namespace
 {
 
-const float ASPECT_RATIO = float(SCREEN_SIZE.x) / SCREEN_SIZE.y;
-
 constexpr int SCREEN_SIZE_MULTIPLIER = 8;
 
-const sf::Color CLIP_COLOR = sf::Color::Black;
+/// Цвет полос, заполняющих область окна вокруг кадра игрового мира.
+const sf::Color LETTERBOX_COLOR = sf::Color::Black;
+
+/*!
+ * Возвращает наибольший целочисленный множитель, с которым кадр игрового
+ * мира помещается в окно.
+ * \param[in] size Размер окна в пикселях.
+ * \param[in] frameSize Размер кадра в пикселях игрового мира.
+ * \return Множитель, не меньший 1.
+ */
+unsigned int maximumScale(const sf::Vector2u &size, const sf::Vector2u &frameSize)
+{
+    const unsigned int scale = std::min(
+        size.x / frameSize.x,
+        size.y / frameSize.y);
+    return std::max(scale, 1u);
+}
 
 }
 
@@ -40,12 +60,10 @@ void Window::setup(const std::string &title)
     m_windowSize = sf::Vector2u(
         SCREEN_SIZE.x * SCREEN_SIZE_MULTIPLIER,
         SCREEN_SIZE.y * SCREEN_SIZE_MULTIPLIER);
-    create();
 
-    m_view = sf::View(sf::FloatRect(0, 0, SCREEN_SIZE.x, SCREEN_SIZE.y));
+    setFrameSize(SCREEN_SIZE);
 
-    m_mask1.setFillColor(CLIP_COLOR);
-    m_mask2.setFillColor(CLIP_COLOR);
+    create();
 }
 
 
@@ -59,7 +77,8 @@ void Window::create()
         sf::VideoMode(m_windowSize.x, m_windowSize.y),
         m_windowTitle,
         style);
-    m_window.setFramerateLimit(FPS_LIMIT);
+    m_window.setFramerateLimit(m_frameLimit ? FPS_LIMIT : 0);
+    resize(m_window.getSize());
 }
 
 
@@ -76,43 +95,62 @@ void Window::onKeyPressed(const sf::Event::KeyEvent &key)
         toggleFullscreen();
         return;
     }
+    if (key.code == sf::Keyboard::F6 && Tracer::instance().enabled())
+    {
+        Tracer::instance().write();
+        return;
+    }
 
     m_keyPressCallback(key);
 }
 
 
-void Window::updateClippingMask(const float aspectRatio)
+void Window::updateFrameSprite()
 {
-    const sf::Vector2f &viewSize = m_view.getSize();
-
-    sf::Vector2f maskSize;
-    if (aspectRatio > ASPECT_RATIO)
-    {
-        // Ширина больше. Маски слева и справа.
-        maskSize = sf::Vector2f((viewSize.x - SCREEN_SIZE.x) / 2.0, viewSize.y);
-        m_mask1.setPosition(-maskSize.x, 0);
-        m_mask2.setPosition(float(SCREEN_SIZE.x), 0);
-    }
-    else
+    const sf::Vector2u size = m_window.getSize();
+    const sf::Vector2u frameSize = m_frame.getSize();
+    if (frameSize.x == 0 || frameSize.y == 0)
     {
-        // Высота больше. Маски сверху и снизу.
-        maskSize = sf::Vector2f(viewSize.x, (viewSize.y - SCREEN_SIZE.y) / 2.0);
-        m_mask1.setPosition(0, -maskSize.y);
-        m_mask2.setPosition(0, float(SCREEN_SIZE.y));
+        return;
     }
-    m_mask1.setSize(maskSize);
-    m_mask2.setSize(maskSize);
+    const unsigned int maximumScale = ::maximumScale(size, frameSize);
+    float scale = float(m_scale == 0
+        ? maximumScale
+        : std::min(m_scale, maximumScale));
+    // Кадр, не помещающийся в окно даже без увеличения, уменьшается.
+    scale = std::min({
+        scale,
+        float(size.x) / frameSize.x,
+        float(size.y) / frameSize.y });
+
+    // Кадр располагается по центру окна, оставшаяся область окна
+    // заполняется полосами цвета LETTERBOX_COLOR.
+    m_frameSprite.setScale(scale, scale);
+    m_frameSprite.setPosition(
+        std::floor((float(size.x) - frameSize.x * scale) / 2),
+        std::floor((float(size.y) - frameSize.y * scale) / 2));
 }
 
 
 void Window::beginDraw()
 {
-    m_window.clear(BACKGROUND_COLOR);
+    m_frame.clear(BACKGROUND_COLOR);
+    m_window.clear(LETTERBOX_COLOR);
+}
+
+
+void Window::drawFrame()
+{
+    m_frame.display();
+    m_window.setView(m_view);
+    m_window.draw(m_frameSprite);
 }
 
 
 void Window::endDraw()
 {
+    PROFILE_ZONE(WindowEndDraw);
+    TRACE_SCOPE("Window::endDraw");
     m_window.display();
 }
 
@@ -136,10 +174,9 @@ bool Window::isFullscreen()
 }
 
 
-sf::RenderWindow& Window::gameWindow() noexcept
+sf::RenderTarget& Window::gameTarget() noexcept
 {
-    m_window.setView(m_view);
-    return m_window;
+    return m_frame;
 }
 
 
@@ -155,26 +192,10 @@ sf::RenderWindow& Window::debugWindow() noexcept
 
 void Window::resize(const sf::Vector2u &size)
 {
-    // Определение количества дополнительных пикселей игрового мира,
-    // которые нужно отобразить, учитывая размер окна в пикселях монитора
-    // и соотношение сторон окна.
-    // SFML 2.4 For Beginners - 11: Views.
-    // https://www.youtube.com/watch?v=CpVbMeYryKo
-    const float aspectRatio = float(size.x) / float(size.y);
-    sf::Vector2u viewSize = SCREEN_SIZE;
-    if (aspectRatio > ASPECT_RATIO)
-    {
-        // Ширина больше.
-        viewSize.x = size.x * SCREEN_SIZE.x / (size.y * ASPECT_RATIO);
-    }
-    else
-    {
-        // Высота больше.
-        viewSize.y = size.y * SCREEN_SIZE.y / (size.x / ASPECT_RATIO);
-    }
-    m_view.setSize(viewSize.x, viewSize.y);
-
-    updateClippingMask(aspectRatio);
+    // Вид окна совпадает с его размером, кадр игрового мира
+    // масштабируется спрайтом m_frameSprite.
+    m_view = sf::View(sf::FloatRect(0, 0, size.x, size.y));
+    updateFrameSprite();
 
     if (m_viewDebug.has_value())
     {
@@ -189,16 +210,25 @@ sf::Vector2u Window::windowSize() const noexcept
 }
 
 
-const sf::Vector2f& Window::viewSize() const noexcept
+void Window::setScale(unsigned int scale)
 {
-    return m_view.getSize();
+    m_scale = scale;
+    updateFrameSprite();
 }
 
 
-void Window::renderClippingMask(sf::RenderWindow &target)
+void Window::setFrameSize(const sf::Vector2u &size)
 {
-    target.draw(m_mask1);
-    target.draw(m_mask2);
+    // Игровой мир рисуется в текстуру его натурального размера, которая
+    // затем выводится в окно одним прямоугольником. Сглаживание отключено,
+    // чтобы увеличение выполнялось по ближайшему соседу.
+    if (!m_frame.create(size.x, size.y))
+    {
+        LOG_ERROR("Unable to create frame render texture " << size.x << 'x' << size.y << '.');
+    }
+    m_frame.setSmooth(false);
+    m_frameSprite.setTexture(m_frame.getTexture(), true);
+    updateFrameSprite();
 }
 
 
@@ -223,8 +253,17 @@ void Window::enableDebugView(bool value)
 }
 
 
+void Window::enableFrameLimit(bool value)
+{
+    m_frameLimit = value;
+    m_window.setFramerateLimit(m_frameLimit ? FPS_LIMIT : 0);
+}
+
+
 void Window::update()
 {
+    PROFILE_ZONE(WindowEvents);
+    TRACE_SCOPE("Window::update");
     sf::Event event;
     while (m_window.pollEvent(event))
     {
@@ -2,11 +2,15 @@
 
 #include <optional>
 #include <set>
+#include <sstream>
 
+#include <game/binary_io.h>
 #include <game/config.h>
 #include <game/initial_position.h>
+#include <game/leaderboard.h>
 #include <game/log.h>
-#include <game/sound_system.h>
+#include <game/profiler.h>
+#include <game/tracer.h>
 
 #include "math/math.h"
 
@@ -52,6 +56,14 @@ const sf::Vector2f SCORE_POSITION_STOPPED(26, 24);
 /// относительно левого верхнего угла.
 const sf::Vector2f HOURGLASS_POSITION(44, 12);
 
+/// Сигнатура сохранённой игры.
+constexpr std::uint32_t SAVE_MAGIC = 0x56534B53; // "SKSV"
+/// Версия формата сохранённой игры.
+constexpr std::uint16_t SAVE_VERSION = 2;
+/// Ограничения, защищающие от чтения повреждённых данных.
+constexpr std::uint32_t MAX_SAVED_BOXES = 1024;
+constexpr std::uint32_t MAX_RANDOM_STATE_SIZE = 16 * 1024;
+
 sf::Vector2f craneStartPosition(
     bool left,
     unsigned int craneWidth,
@@ -110,6 +122,7 @@ Player::Direction directionByKey(sf::Keyboard::Key key)
 World::World()
     : m_player(
         std::bind(&World::onPlayerMoveFinished, this, std::placeholders::_1))
+    , m_soundSink(&NullSoundSink::instance())
 {
     setup();
 }
@@ -117,6 +130,40 @@ World::World()
 
 void World::start(const std::optional<unsigned int> &positionIndex)
 {
+    std::random_device device;
+    start(positionIndex, device(), Config::instance().cranesQuantity());
+}
+
+
+void World::start(const Replay &replay)
+{
+    m_debugMode = replay.debugMode;
+    start(replay.positionIndex, replay.seed, replay.cranesQuantity);
+    // Записи инструментов разработки (WorldInspector::start()) могут
+    // начинаться с большим количеством кранов, чем допускает игра.
+    const std::size_t cranesQuantity =
+        std::min(std::size_t(replay.cranesQuantity), MAX_CRANES_QUANTITY);
+    while (this->cranesQuantity() < cranesQuantity)
+    {
+        addCrane();
+    }
+}
+
+
+void World::start(
+    const std::optional<unsigned int> &positionIndex,
+    std::uint32_t seed,
+    std::uint8_t cranesQuantity)
+{
+    m_randomEngine.seed(seed);
+    m_replay = Replay();
+    m_replay.seed = seed;
+    m_replay.positionIndex = positionIndex;
+    m_replay.cranesQuantity = cranesQuantity;
+    m_replay.debugMode = m_debugMode;
+    m_tick = 0;
+    m_gameId = EventLog::instance().newGame();
+
     // Удаление старых объектов.
     clearObjects();
     m_scoreFigure.reset();
@@ -141,7 +188,7 @@ void World::start(const std::optional<unsigned int> &positionIndex)
     setPlayerColumn(playerColumn);
     m_player.setAlive(true);
 
-    addCranes(Config::instance().cranesQuantity);
+    addCranes(cranesQuantity);
 
     m_score = 0;
     m_paused = false;
@@ -152,11 +199,29 @@ void World::start(const std::optional<unsigned int> &positionIndex)
 void World::setDebugMode(bool value)
 {
     m_debugMode = value;
+    // Краны, добавленные до выключения отладки, остаются в записи игры.
+    m_replay.debugMode = m_replay.debugMode || value;
+}
+
+
+void World::setSoundSink(SoundSink &sink)
+{
+    m_soundSink = &sink;
+}
+
+
+void World::setPlayerName(const std::string &name, Leaderboard::Board board)
+{
+    m_playerName = name;
+    m_leaderboard = board;
 }
 
 
 void World::update(const Duration &elapsed)
 {
+    TRACE_SCOPE("World::update");
+    m_replay.addTick(elapsed);
+    ++m_tick;
     m_updater(elapsed);
 }
 
@@ -186,6 +251,12 @@ void World::movePlayer(const Player::Direction direction)
         return;
     }
 
+    logEvent(
+        EventLog::Type::PlayerMove,
+        direction,
+        playerCoordinates.row.value_or(0),
+        playerCoordinates.column.value_or(0));
+
     const bool push = pushedBoxId != NULL_ID;
     if (push)
     {
@@ -210,7 +281,9 @@ void World::movePlayer(const Player::Direction direction)
 
 void World::draw(sf::RenderTarget &target, sf::RenderStates) const
 {
+    PROFILE_ZONE(WorldDraw);
     target.draw(m_background);
+    std::size_t drawCalls = 1;
 
     // Отрисковка в преобразованной системе координат.
     {
@@ -219,7 +292,7 @@ void World::draw(sf::RenderTarget &target, sf::RenderStates) const
         {
             if (crane != nullptr)
             {
-                renderCrane(*crane, target);
+                drawCalls += renderCrane(*crane, target);
             }
         }
 
@@ -234,26 +307,83 @@ void World::draw(sf::RenderTarget &target, sf::RenderStates) const
                 }
                 const BoxPtr &box = m_boxes.at(boxId);
                 target.draw(*box, m_transform);
+                ++drawCalls;
             }
         }
         for (const Object::Id boxId : m_boxesMoving)
         {
             const BoxPtr &box = m_boxes.at(boxId);
             target.draw(*box, m_transform);
+            ++drawCalls;
         }
 
         // Отображение игрока.
         target.draw(m_player, m_transform);
+        ++drawCalls;
     }
 
     // Отображение счёта.
     if (m_scoreFigure != nullptr)
     {
         target.draw(*m_scoreFigure);
+        drawCalls += m_scoreFigure->drawCalls();
     }
 
     // Отображение переднего плана.
     target.draw(m_foreground);
+    m_drawCalls = drawCalls + 1;
+}
+
+
+void World::drawSprites(SpriteSink &sink) const
+{
+    sink.draw(m_background, ResourceLoader::TextureId::Background);
+
+    for (const CranePtr &crane : m_cranes)
+    {
+        if (crane == nullptr)
+        {
+            continue;
+        }
+        sink.draw(*crane, ResourceLoader::TextureId::Crane, m_transform);
+        if (crane->boxId() != NULL_ID)
+        {
+            sink.draw(
+                *m_boxes.at(crane->boxId()),
+                ResourceLoader::TextureId::Box,
+                m_transform);
+        }
+    }
+
+    for (auto &column : m_boxesStatic)
+    {
+        for (const Object::Id boxId : column)
+        {
+            if (boxId != NULL_ID)
+            {
+                sink.draw(*m_boxes.at(boxId), ResourceLoader::TextureId::Box, m_transform);
+            }
+        }
+    }
+    for (const Object::Id boxId : m_boxesMoving)
+    {
+        sink.draw(*m_boxes.at(boxId), ResourceLoader::TextureId::Box, m_transform);
+    }
+
+    sink.draw(m_player, ResourceLoader::TextureId::Player, m_transform);
+
+    if (m_scoreFigure != nullptr)
+    {
+        m_scoreFigure->drawSprites(sink);
+    }
+
+    sink.draw(m_foreground, ResourceLoader::TextureId::Foreground);
+}
+
+
+std::size_t World::drawCalls() const noexcept
+{
+    return m_drawCalls;
 }
 
 
@@ -263,8 +393,22 @@ boost::signals2::connection World::connectClose(const Slot &slot)
 }
 
 
+boost::signals2::connection World::connectGameOver(const Slot &slot)
+{
+    return m_signalGameOver.connect(slot);
+}
+
+
 bool World::handleKeyPressed(const sf::Keyboard::Key key)
 {
+    // Без отладки клавиша не действует и не попадает в запись игры,
+    // иначе она подействовала бы при воспроизведении в режиме отладки.
+    if (key == KEY_ADD_CRANE && !m_debugMode)
+    {
+        return false;
+    }
+    m_replay.inputs.push_back(Replay::Input{ m_tick, key, true });
+
     if (!m_player.alive())
     {
         if (key == KEY_BACK)
@@ -278,12 +422,8 @@ bool World::handleKeyPressed(const sf::Keyboard::Key key)
     switch (key)
     {
     case KEY_ADD_CRANE:
-        if (m_debugMode)
-        {
-            addCrane();
-            return true;
-        }
-        break;
+        addCrane();
+        return true;
     case KEY_GOD_MODE:
         m_godMode = !m_godMode;
         return true;
@@ -311,6 +451,8 @@ bool World::handleKeyPressed(const sf::Keyboard::Key key)
 
 void World::handleKeyReleased(const sf::Keyboard::Key key)
 {
+    m_replay.inputs.push_back(Replay::Input{ m_tick, key, false });
+
     const Player::Direction requestedDirection = directionByKey(key);
     if (requestedDirection == Player::Direction::None)
     {
@@ -333,11 +475,225 @@ unsigned int World::score() const noexcept
 }
 
 
-void World::setup()
+const Replay& World::replay() const noexcept
 {
-    std::random_device device;
-    m_randomEngine = std::mt19937(device());
+    return m_replay;
+}
+
+
+bool World::gameOver() const noexcept
+{
+    return !m_player.alive();
+}
+
+
+void World::save(std::ostream &stream) const
+{
+    Snapshot snapshot;
+    makeSnapshot(snapshot);
+    save(stream, m_replay, snapshot);
+}
+
+
+void World::makeSnapshot(Snapshot &snapshot) const
+{
+    snapshot.gameId = m_gameId;
+    snapshot.tick = m_tick;
+    snapshot.score = std::uint32_t(m_score);
+    snapshot.paused = m_paused;
+    snapshot.godMode = m_godMode;
+    snapshot.playerRequestedDirection = m_playerRequestedDirection;
+    snapshot.randomEngine = m_randomEngine;
 
+    std::ostringstream objects;
+    BinaryWriter writer(objects);
+    m_player.save(writer);
+
+    writer.write(std::uint32_t(m_boxes.size()));
+    for (const auto &[id, box] : m_boxes)
+    {
+        writer.write(std::uint64_t(id));
+        writer.write(std::uint8_t(box->restStyle()));
+        box->save(writer);
+    }
+    for (const auto &column : m_boxesStatic)
+    {
+        for (const Object::Id boxId : column)
+        {
+            writer.write(std::uint64_t(boxId));
+        }
+    }
+    writer.write(std::uint32_t(m_boxesMoving.size()));
+    for (const Object::Id boxId : m_boxesMoving)
+    {
+        writer.write(std::uint64_t(boxId));
+    }
+
+    for (const CranePtr &crane : m_cranes)
+    {
+        writer.write(crane != nullptr);
+        if (crane != nullptr)
+        {
+            crane->save(writer);
+        }
+    }
+    snapshot.objects = objects.str();
+}
+
+
+void World::save(std::ostream &stream, const Replay &replay, const Snapshot &snapshot)
+{
+    BinaryWriter writer(stream);
+    writer.write(SAVE_MAGIC);
+    writer.write(SAVE_VERSION);
+    writeReplay(writer, replay);
+    writer.write(snapshot.tick);
+    writer.write(snapshot.score);
+    writer.write(snapshot.paused);
+    writer.write(snapshot.godMode);
+    writer.write(snapshot.playerRequestedDirection);
+
+    std::ostringstream randomState;
+    randomState << snapshot.randomEngine;
+    const std::string randomStateText = randomState.str();
+    writer.write(std::uint32_t(randomStateText.size()));
+    for (const char c : randomStateText)
+    {
+        writer.write(c);
+    }
+
+    stream.write(snapshot.objects.data(), std::streamsize(snapshot.objects.size()));
+}
+
+
+bool World::restore(std::istream &stream)
+{
+    BinaryReader reader(stream);
+    std::uint32_t magic{ 0 };
+    std::uint16_t version{ 0 };
+    reader.read(magic);
+    reader.read(version);
+    if (magic != SAVE_MAGIC || version != SAVE_VERSION)
+    {
+        LOG_ERROR("Saved game is not of version " << SAVE_VERSION << '.');
+        return false;
+    }
+
+    Replay replay;
+    std::uint32_t score{ 0 };
+    std::uint32_t randomStateSize{ 0 };
+    readReplay(reader, replay);
+    reader.read(m_tick);
+    reader.read(score);
+    reader.read(m_paused);
+    reader.read(m_godMode);
+    reader.read(m_playerRequestedDirection);
+    reader.read(randomStateSize);
+    if (!reader.good() || randomStateSize > MAX_RANDOM_STATE_SIZE)
+    {
+        LOG_ERROR("Saved game is corrupted.");
+        return false;
+    }
+    std::string randomStateText(randomStateSize, '\0');
+    for (char &c : randomStateText)
+    {
+        reader.read(c);
+    }
+    std::istringstream randomState(randomStateText);
+    randomState >> m_randomEngine;
+
+    m_replay = std::move(replay);
+    m_score = score;
+    m_gameId = EventLog::instance().newGame();
+    clearObjects();
+    m_scoreFigure.reset();
+    m_player.restore(reader);
+
+    // Объекты получают новые идентификаторы, поэтому ссылки
+    // на ящики переводятся из записанных идентификаторов в новые.
+    std::map<Object::Id, Object::Id> ids;
+    bool valid = !randomState.fail();
+    const auto newId = [&ids, &valid](std::uint64_t id)
+    {
+        if (id == NULL_ID)
+        {
+            return NULL_ID;
+        }
+        const auto it = ids.find(Object::Id(id));
+        if (it == ids.cend())
+        {
+            valid = false;
+            return NULL_ID;
+        }
+        return it->second;
+    };
+
+    std::uint32_t size{ 0 };
+    reader.read(size);
+    valid = valid && size <= MAX_SAVED_BOXES;
+    for (std::uint32_t i = 0; i < size && valid && reader.good(); ++i)
+    {
+        std::uint64_t id{ 0 };
+        std::uint8_t restStyle{ 0 };
+        reader.read(id);
+        reader.read(restStyle);
+        if (restStyle >= Box::restStylesQuantity())
+        {
+            valid = false;
+            break;
+        }
+        const BoxPtr box = makeBox(restStyle);
+        box->restore(reader);
+        ids[Object::Id(id)] = box->id();
+    }
+    for (auto &column : m_boxesStatic)
+    {
+        for (Object::Id &boxId : column)
+        {
+            std::uint64_t id{ 0 };
+            reader.read(id);
+            boxId = newId(id);
+        }
+    }
+    size = 0;
+    reader.read(size);
+    valid = valid && size <= MAX_SAVED_BOXES;
+    for (std::uint32_t i = 0; i < size && valid && reader.good(); ++i)
+    {
+        std::uint64_t id{ 0 };
+        reader.read(id);
+        m_boxesMoving.insert(newId(id));
+    }
+
+    for (CranePtr &crane : m_cranes)
+    {
+        bool present{ false };
+        reader.read(present);
+        if (present && reader.good())
+        {
+            crane = makeCrane();
+            crane->restore(reader);
+            crane->load(newId(crane->boxId()));
+        }
+    }
+
+    if (!reader.good() || !valid || m_boxesMoving.count(NULL_ID) != 0)
+    {
+        LOG_ERROR("Saved game is corrupted.");
+        clearObjects();
+        return false;
+    }
+
+    m_paused ? pause() : resume();
+    LOG_INFO(
+        "Game has been restored: tick " << m_tick << ", score " << m_score
+        << ", " << m_boxes.size() << " boxes.");
+    return true;
+}
+
+
+void World::setup()
+{
     m_transform = sf::Transform();
     // Переход в систему координат, у которой начало в левом нижнем углу
     // игровой области, ось X направлена вправо, ось Y направлена вверх.
@@ -346,11 +702,23 @@ void World::setup()
     m_transform.scale(sf::Vector2f(1, -1));
 
     ResourceLoader &resourceLoader = ResourceLoader::instance();
-    m_background.setTexture(
-        *resourceLoader.texture(ResourceLoader::TextureId::Background));
-    m_foreground.setTexture(
-        *resourceLoader.texture(ResourceLoader::TextureId::Foreground));
+    resourceLoader.applyTexture(m_background, ResourceLoader::TextureId::Background);
+    resourceLoader.applyTexture(m_foreground, ResourceLoader::TextureId::Foreground);
     m_foreground.setColor(BACKGROUND_COLOR);
+
+    m_boxesMoving.reserve(MAX_BOXES_QUANTITY);
+    m_boxesMovingSnapshot.reserve(MAX_BOXES_QUANTITY);
+    m_freeBoxes.reserve(MAX_BOXES_QUANTITY);
+    for (std::size_t i = 0; i < MAX_BOXES_QUANTITY; ++i)
+    {
+        makeBox(0);
+    }
+    m_freeCranes.reserve(MAX_CRANES_QUANTITY);
+    for (std::size_t i = 0; i < MAX_CRANES_QUANTITY; ++i)
+    {
+        m_freeCranes.push_back(std::make_shared<Crane>());
+    }
+    clearObjects();
 }
 
 
@@ -374,11 +742,18 @@ void World::pause()
 
 void World::clearObjects()
 {
-    m_boxes.clear();
+    while (!m_boxes.empty())
+    {
+        m_freeBoxes.push_back(m_boxes.extract(m_boxes.begin()));
+    }
 
     for (auto &crane : m_cranes)
     {
-        crane.reset();
+        if (crane != nullptr)
+        {
+            m_freeCranes.push_back(crane);
+            crane.reset();
+        }
     }
 
     // Удаление индексов.
@@ -452,14 +827,45 @@ void World::generatePredefinedPosition(const InitialPosition &initialPosition)
 
 BoxPtr World::makeBox()
 {
-    BoxPtr box = std::make_shared<Box>(
-        std::bind(&World::onBoxMoveStarted, this, std::placeholders::_1),
-        std::bind(&World::onBoxMoveFinished, this, std::placeholders::_1));
-    m_boxes.emplace(box->id(), box);
+    std::uniform_int_distribution<std::size_t> distributionStyle(
+        0,
+        Box::restStylesQuantity() - 1);
+    return makeBox(distributionStyle(m_randomEngine));
+}
+
+
+BoxPtr World::makeBox(std::size_t restStyle)
+{
+    if (m_freeBoxes.empty())
+    {
+        BoxPtr box = std::make_shared<Box>(
+            restStyle,
+            std::bind(&World::onBoxMoveStarted, this, std::placeholders::_1),
+            std::bind(&World::onBoxMoveFinished, this, std::placeholders::_1));
+        m_boxes.emplace(box->id(), box);
+        return box;
+    }
+
+    Boxes::node_type node = std::move(m_freeBoxes.back());
+    m_freeBoxes.pop_back();
+    BoxPtr box = node.mapped();
+    box->recycle(restStyle);
+    node.key() = box->id();
+    m_boxes.insert(std::move(node));
     return box;
 }
 
 
+void World::releaseBox(Object::Id boxId)
+{
+    Boxes::node_type node = m_boxes.extract(boxId);
+    if (!node.empty())
+    {
+        m_freeBoxes.push_back(std::move(node));
+    }
+}
+
+
 BoxPtr World::addBox(Coordinate row, Coordinate column)
 {
     BoxPtr box = makeBox();
@@ -493,7 +899,7 @@ void World::addCrane()
     }
 
     LOG_DEBUG("Adding new crane.");
-    CranePtr crane = std::make_shared<Crane>();
+    CranePtr crane = makeCrane();
     // Первый кран добавляется в начале игры.
     // Он имеет нулевые индекс и смещение.
     unsigned int craneIndex = 0;
@@ -538,6 +944,19 @@ void World::addCrane()
 }
 
 
+CranePtr World::makeCrane()
+{
+    if (m_freeCranes.empty())
+    {
+        return std::make_shared<Crane>();
+    }
+    CranePtr crane = std::move(m_freeCranes.back());
+    m_freeCranes.pop_back();
+    crane->recycle();
+    return crane;
+}
+
+
 std::size_t World::cranesQuantity() const noexcept
 {
     std::size_t cranesQuantity = 0;
@@ -963,6 +1382,7 @@ void World::onBoxMoveFinished(Object::Id boxId)
 
 void World::updatePlayer(const Duration &elapsed)
 {
+    PROFILE_ZONE(UpdatePlayer);
     m_player.update(elapsed);
 
     if (m_playerRequestedDirection != Player::Direction::None
@@ -1008,6 +1428,7 @@ void World::updatePlayer(const Duration &elapsed)
 
 void World::updateBoxes(const Duration &elapsed)
 {
+    PROFILE_ZONE(UpdateBoxes);
     // Обновление стоящих ящиков.
     for (auto &column : m_boxesStatic)
     {
@@ -1024,16 +1445,16 @@ void World::updateBoxes(const Duration &elapsed)
 
     // Обновление движущихся ящиков.
     // Копирование списка ящиков, т.к. он может меняться внутри цикла.
-    auto boxesMoving = m_boxesMoving;
-    for (auto it = boxesMoving.begin(); it != boxesMoving.end(); ++it)
+    // Ёмкость копии сохраняется между обновлениями.
+    m_boxesMovingSnapshot.assign(m_boxesMoving.cbegin(), m_boxesMoving.cend());
+    for (const Object::Id boxId : m_boxesMovingSnapshot)
     {
-        const Object::Id boxId = *it;
         BoxPtr &box = m_boxes[boxId];
         const bool blowedByPlayer = updateBox(*box.get(), elapsed);
         if (blowedByPlayer)
         {
-            m_boxesMoving.erase(box->id());
-            m_boxes.erase(box->id());
+            m_boxesMoving.erase(boxId);
+            releaseBox(boxId);
         }
     }
 }
@@ -1098,6 +1519,7 @@ bool World::updateBox(Box &box, const Duration &elapsed)
 
 void World::updateCrane(Crane &crane, const Duration &elapsed)
 {
+    PROFILE_ZONE(UpdateCrane);
     crane.update(elapsed);
 
     if (crane.boxId() != NULL_ID)
@@ -1143,6 +1565,11 @@ void World::pushBox(Box &box, Box::Direction direction)
     }
     box.move(direction);
     m_boxesMoving.insert(box.id());
+    logEvent(
+        EventLog::Type::BoxPush,
+        std::uint8_t(direction),
+        column.value_or(0),
+        std::uint32_t(box.id()));
 }
 
 
@@ -1201,6 +1628,11 @@ void World::dropBox(Crane &crane)
     // падающий в соседней колонке, не пересекался с ним по горизонтали
     // и не упирался в него.
     m_boxes[crane.boxId()]->normalizePosition(true, false);
+    logEvent(
+        EventLog::Type::BoxDrop,
+        m_boxes[crane.boxId()]->column().value_or(0),
+        0,
+        std::uint32_t(crane.boxId()));
     crane.drop();
     // Очки за сборс начисляются, если игрок жив.
     if (m_player.alive())
@@ -1238,7 +1670,7 @@ bool World::blowBottomRow()
         }
         else
         {
-            m_boxes.erase(bottomBoxId);
+            releaseBox(bottomBoxId);
             column.front() = NULL_ID;
         }
     }
@@ -1246,6 +1678,11 @@ bool World::blowBottomRow()
     {
         const std::size_t cranesQuantity = this->cranesQuantity();
         m_score += cranesQuantity * BLOW_BOTTOM_ROW_SCORE_MULTIPLIER;
+        logEvent(
+            EventLog::Type::RowBlow,
+            std::uint8_t(cranesQuantity),
+            0,
+            m_score);
         playSound(ResourceLoader::SoundId::Score);
     }
     return rowBlowed;
@@ -1266,15 +1703,17 @@ Coordinate World::columnHeight(Coordinate column) const noexcept
 }
 
 
-void World::renderCrane(Crane &crane, sf::RenderTarget &target) const
+std::size_t World::renderCrane(Crane &crane, sf::RenderTarget &target) const
 {
     target.draw(crane, m_transform);
 
-    if (crane.boxId() != NULL_ID)
+    if (crane.boxId() == NULL_ID)
     {
-        const BoxPtr &box = m_boxes.at(crane.boxId());
-        target.draw(*box, m_transform);
+        return 1;
     }
+    const BoxPtr &box = m_boxes.at(crane.boxId());
+    target.draw(*box, m_transform);
+    return 2;
 }
 
 
@@ -1344,22 +1783,43 @@ std::optional<Object::Id> World::levitationBoxId(
 
 void World::playSound(ResourceLoader::SoundId id)
 {
-    SoundSystem::instance().playSound(id);
+    m_soundSink->playSound(id);
+}
+
+
+void World::logEvent(
+    EventLog::Type type,
+    std::uint8_t argument0,
+    std::uint16_t argument1,
+    std::uint32_t argument2) const
+{
+    EventLog::instance().write(
+        EventLog::Record{ m_gameId, m_tick, type, argument0, argument1, argument2 });
 }
 
 
 void World::stop()
 {
     LOG_INFO("Game over. Score: " << m_score << '.');
-    m_player.setAlive(false);
+    logEvent(EventLog::Type::GameOver, 0, 0, m_score);
+    std::uniform_int_distribution<std::mt19937::result_type> distributionDirection(0, 1);
+    m_player.setAlive(false, distributionDirection(m_randomEngine) == 0);
     playSound(ResourceLoader::SoundId::GameOver);
 
     m_scoreFigure.reset(new Score(m_score));
     m_scoreFigure->setFramePosition(SCORE_POSITION_STOPPED);
     m_scoreFigure->enableBlinking(true);
 
-    Config &config = Config::instance();
-    config.highScore = std::max(config.highScore, m_score);
+    if (m_playerName.has_value())
+    {
+        Leaderboard::instance().add(
+            m_leaderboard,
+            m_replay.cranesQuantity,
+            m_playerName.value(),
+            m_score);
+    }
+
+    m_signalGameOver();
 }
 
 
@@ -1,5 +1,27 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <game/autosave.h>
+#include <game/benchmark_screen.h>
+#include <game/event_log.h>
 #include <game/game.h>
 #include <game/log.h>
+#include <game/performance_counters.h>
+#include <game/replay.h>
+#include <game/replay_exporter.h>
+#include <game/resource_loader.h>
+#include <game/resource_pack.h>
+#include <game/tracer.h>
 #include <game/version/version.h>
 
 
@@ -52,21 +74,284 @@ LONG WINAPI customUnhandledExceptionFilter(PEXCEPTION_POINTERS pExInfo)
 #endif // BUILD_WITH_WINDOWSCRASHDUMP
 
 
-std::optional<unsigned int> positionNumber(const char *string)
+#ifdef EMBED_RESOURCE_PACK
+extern const unsigned char RESOURCE_PACK_DATA[];
+extern const std::size_t RESOURCE_PACK_SIZE;
+#endif
+
+
+/*!
+ * Передаёт загрузчику ресурсов архив ресурсов: встроенный в исполняемый
+ * файл либо файл resources.pak (ResourceLoader::openResourcePack()).
+ * \param[in] executablePath Путь к исполняемому файлу.
+ * \return \c false, если архив есть, но открыть его не удалось.
+ */
+bool openResourcePack(const char *executablePath)
+{
+#ifdef EMBED_RESOURCE_PACK
+    std::ignore = executablePath;
+    std::shared_ptr<ResourcePack> pack = std::make_shared<ResourcePack>();
+    if (!pack->open(RESOURCE_PACK_DATA, RESOURCE_PACK_SIZE))
+    {
+        return false;
+    }
+    ResourceLoader::instance().setResourcePack(pack);
+    return true;
+#else
+    return ResourceLoader::instance().openResourcePack(executablePath);
+#endif
+}
+
+
+std::optional<unsigned int> parseNumber(const char *string)
 {
-    std::optional<unsigned int> position;
+    std::optional<unsigned int> number;
     std::size_t pos{};
     try
     {
-        position = std::stoi(string, &pos);
+        number = std::stoi(string, &pos);
     }
     catch (const std::exception &ex)
     {
         LOG_ERROR(
-            "Unable to cast position with number \"" << string
-            << "\". Error: " << ex.what() << ".");
+            "Unable to cast \"" << string
+            << "\" to number. Error: " << ex.what() << ".");
+    }
+    return number;
+}
+
+
+/*!
+ * Извлекает из аргументов командной строки параметр со значением.
+ * \param[in,out] argc Количество аргументов.
+ * \param[in,out] argv Аргументы. Параметр и его значение удаляются.
+ * \param[in] name Название параметра.
+ * \return Значение параметра либо \c nullptr, если параметр не задан.
+ */
+const char* takeOption(int &argc, char *argv[], const char *name)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::strcmp(argv[i], name) == 0)
+        {
+            const char *value = argv[i + 1];
+            std::copy(argv + i + 2, argv + argc, argv + i);
+            argc -= 2;
+            return value;
+        }
+    }
+    return nullptr;
+}
+
+
+/*!
+ * Извлекает из аргументов командной строки параметр без значения.
+ * \param[in,out] argc Количество аргументов.
+ * \param[in,out] argv Аргументы. Параметр удаляется.
+ * \param[in] name Название параметра.
+ * \return \c true, если параметр задан.
+ */
+bool takeFlag(int &argc, char *argv[], const char *name)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], name) == 0)
+        {
+            std::copy(argv + i + 1, argv + argc, argv + i);
+            --argc;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/*!
+ * Экспортирует запись игры покадрово без создания окна.
+ * \param[in] replayPath Путь к файлу записи игры.
+ * \param[in] directory Каталог, в который сохраняются кадры.
+ * \return Код завершения приложения.
+ */
+int exportReplay(const char *replayPath, const char *directory)
+{
+    Replay replay;
+    if (!readReplay(replayPath, replay))
+    {
+        return 1;
+    }
+    // Экспорту не нужны текстуры и окно, только изображения.
+    if (!ResourceLoader::instance().loadImages())
+    {
+        LOG_ERROR("Failed to load resources.");
+        return 1;
+    }
+    ReplayExporter exporter(directory);
+    return exporter.exportReplay(replay) ? 0 : 1;
+}
+
+
+namespace
+{
+
+/// Количество кадров измерения по умолчанию: минута игры при FPS_LIMIT.
+constexpr unsigned int BENCHMARK_FRAMES = 60 * FPS_LIMIT;
+
+}
+
+
+/// \return Процессорное время всех потоков процесса с его запуска.
+Duration processCpuTime()
+{
+#ifdef _WIN32
+    FILETIME creationTime;
+    FILETIME exitTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+    if (!GetProcessTimes(
+        GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+        return Duration(0);
+    }
+    // Время измеряется в интервалах по 100 нс.
+    const auto seconds = [](const FILETIME &time)
+    {
+        ULARGE_INTEGER value;
+        value.LowPart = time.dwLowDateTime;
+        value.HighPart = time.dwHighDateTime;
+        return double(value.QuadPart) / 10000000;
+    };
+    return Duration(seconds(kernelTime) + seconds(userTime));
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return Duration(0);
+    }
+    const auto seconds = [](const timeval &time)
+    {
+        return double(time.tv_sec) + double(time.tv_usec) / 1000000;
+    };
+    return Duration(seconds(usage.ru_utime) + seconds(usage.ru_stime));
+#endif
+}
+
+
+/*!
+ * Выводит статистику длительности кадров.
+ * \param[in] frameTimes Длительности кадров.
+ * \param[in] drawCalls Количество вызовов отрисовки во всех кадрах.
+ * \param[in] cpuTime Процессорное время всех потоков приложения.
+ */
+void printBenchmarkReport(
+    std::vector<Duration> frameTimes,
+    std::size_t drawCalls,
+    const Duration &cpuTime)
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const auto milliseconds = [](const Duration &duration)
+    {
+        return Milliseconds(duration).count();
+    };
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+    Duration total(0);
+    for (const Duration &frameTime : frameTimes)
+    {
+        total += frameTime;
+    }
+    const std::size_t frames = frameTimes.size();
+    const auto percentile = [&frameTimes, frames](std::size_t percent)
+    {
+        return frameTimes[std::min(frames - 1, frames * percent / 100)];
+    };
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "Frames:               " << frames << '\n'
+        << "Frame time, ms:       min " << milliseconds(frameTimes.front())
+        << ", avg " << milliseconds(total / double(frames))
+        << ", p50 " << milliseconds(percentile(50))
+        << ", p99 " << milliseconds(percentile(99))
+        << ", max " << milliseconds(frameTimes.back()) << '\n'
+        << "Frames per second:    " << double(frames) / total.count() << '\n'
+        << "Draw calls per frame: " << double(drawCalls) / double(frames) << '\n'
+        << "Wall time, s:         " << total.count() << '\n'
+        << "CPU time, s:          " << cpuTime.count() << std::endl;
+}
+
+
+/*!
+ * Измеряет длительность кадров игры бота по встроенному сценарию.
+ * Мир отрисовывается в окне, частота кадров не ограничивается.
+ * \param[in] scenarioName Название сценария из BENCHMARK_SCENARIOS.
+ * \param[in] frames Количество измеряемых кадров.
+ * \return Код завершения приложения.
+ */
+int runBenchmark(const std::string &scenarioName, unsigned int frames)
+{
+    const auto scenario = std::find_if(
+        BENCHMARK_SCENARIOS.cbegin(),
+        BENCHMARK_SCENARIOS.cend(),
+        [&scenarioName](const BenchmarkScenario &item)
+        {
+            return item.name == scenarioName;
+        });
+    if (scenario == BENCHMARK_SCENARIOS.cend())
+    {
+        std::ostringstream names;
+        for (const BenchmarkScenario &item : BENCHMARK_SCENARIOS)
+        {
+            names << ' ' << item.name;
+        }
+        LOG_ERROR(
+            "Unknown benchmark scenario \"" << scenarioName
+            << "\". Available scenarios:" << names.str() << '.');
+        return 1;
+    }
+    if (frames == 0)
+    {
+        LOG_ERROR("Number of benchmark frames must be positive.");
+        return 1;
+    }
+    // Ресурсы загружаются до начала измерения, без экрана загрузки.
+    if (!ResourceLoader::instance().load())
+    {
+        LOG_ERROR("Failed to load resources.");
+        return 1;
+    }
+
+    Game game;
+    const std::shared_ptr<const BenchmarkScreen> screen = game.startBenchmark(*scenario);
+    std::vector<Duration> frameTimes;
+    frameTimes.reserve(frames);
+    // Кадр игрового мира выводится в окно ещё одним вызовом отрисовки.
+    std::size_t drawCalls = 0;
+    const Duration cpuStart = processCpuTime();
+    while (frameTimes.size() < frames && !game.isDone())
+    {
+        const TimePoint start = Clock::now();
+        game.restartClock();
+        game.update();
+        game.render();
+        frameTimes.push_back(Clock::now() - start);
+        drawCalls += screen->drawCalls() + 1;
+    }
+    const Duration cpuTime = processCpuTime() - cpuStart;
+
+    if (frameTimes.empty())
+    {
+        LOG_ERROR("Benchmark has been interrupted before the first frame.");
+        return 1;
     }
-    return position;
+    if (frameTimes.size() < frames)
+    {
+        LOG_WARNING(
+            "Benchmark has been interrupted after " << frameTimes.size()
+            << " of " << frames << " frames.");
+    }
+    std::cout << "Scenario:             " << scenario->name
+        << " (" << scenario->description << ")\n";
+    printBenchmarkReport(std::move(frameTimes), drawCalls, cpuTime);
+    return 0;
 }
 
 
@@ -86,18 +371,89 @@ int main(int argc, char *argv[])
     std::ignore = hOldFilter;
 #endif // BUILD_WITH_WINDOWSCRASHDUMP
 
+    if (!openResourcePack(argv[0]))
+    {
+        LOG_ERROR("Failed to open resource pack.");
+        return 1;
+    }
+
+    // Параметры "--event-log <файл>" и "--trace <файл>" допустимы в любом
+    // режиме запуска. Трасса записывается при выходе и по клавише F6.
+    const char *eventLogPath = takeOption(argc, argv, "--event-log");
+    if (eventLogPath != nullptr && !EventLog::instance().open(eventLogPath))
+    {
+        return 1;
+    }
+    const char *tracePath = takeOption(argc, argv, "--trace");
+    if (tracePath != nullptr && !Tracer::instance().open(tracePath))
+    {
+        return 1;
+    }
+    Tracer::instance().setThreadName("main");
+    // Счётчики игрового потока выводятся на отладочный экран (F3).
+    // Если они недоступны, игра продолжает работу без них.
+    if (takeFlag(argc, argv, "--perf-counters"))
+    {
+        PerformanceCounters::thread().open();
+    }
+
+    const char *benchmarkScenario = takeOption(argc, argv, "--benchmark");
+    if (benchmarkScenario != nullptr)
+    {
+        const char *benchmarkFrames = takeOption(argc, argv, "--frames");
+        const int result = runBenchmark(
+            benchmarkScenario,
+            benchmarkFrames != nullptr
+                ? parseNumber(benchmarkFrames).value_or(0)
+                : BENCHMARK_FRAMES);
+        Tracer::instance().close();
+        EventLog::instance().close();
+        LOG_INFO("--- Exiting ---");
+        return result;
+    }
+
+    if (argc > 3 && std::strcmp(argv[1], "--export") == 0)
+    {
+        const int result = exportReplay(argv[2], argv[3]);
+        Tracer::instance().close();
+        EventLog::instance().close();
+        LOG_INFO("--- Exiting ---");
+        return result;
+    }
+
+    // Файл-признак работы игры остаётся после аварийного завершения.
+    // Проверяется до создания игры, которая создаёт его заново.
+    std::optional<std::string> recovery;
+    if (Autosave::uncleanExit())
+    {
+        LOG_WARNING("Previous run has not exited cleanly.");
+        recovery = Autosave::readNewest();
+    }
+
     Game game;
     if (game.init())
     {
-        LOG_INFO("All resources loaded.");
+        LOG_INFO("Application initialized.");
     }
     else
     {
         LOG_ERROR("Failed to initialize application.");
         return 1;
     }
-    const std::optional<unsigned int> position = argc > 1 ? positionNumber(argv[1]) : std::nullopt;
-    game.start(position);
+    if (argc > 2 && std::strcmp(argv[1], "--spectate") == 0)
+    {
+        const std::optional<unsigned int> worldsQuantity = parseNumber(argv[2]);
+        game.startSpectator(worldsQuantity.value_or(1));
+    }
+    else
+    {
+        const std::optional<unsigned int> position = argc > 1 ? parseNumber(argv[1]) : std::nullopt;
+        if (recovery.has_value())
+        {
+            game.offerRecovery(std::move(recovery.value()));
+        }
+        game.start(position);
+    }
     while (!game.isDone())
     {
         game.restartClock();
@@ -105,6 +461,8 @@ int main(int argc, char *argv[])
         game.render();
     }
 
+    Tracer::instance().close();
+    EventLog::instance().close();
     LOG_INFO("--- Exiting ---");
 
     return 0;
@@ -0,0 +1,64 @@
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <game/log.h>
+#include <game/resource_pack.h>
+
+
+/*!
+ * Записывает архив в исходный файл C++ в виде массива,
+ * чтобы встроить его в исполняемый файл.
+ * \param[in] packPath Путь к архиву.
+ * \param[in] sourcePath Путь к создаваемому исходному файлу.
+ * \return \c true, если исходный файл записан.
+ */
+bool writeSource(const std::filesystem::path &packPath, const std::filesystem::path &sourcePath)
+{
+    std::ifstream pack(packPath, std::ios::binary);
+    const std::vector<char> data(
+        (std::istreambuf_iterator<char>(pack)),
+        std::istreambuf_iterator<char>());
+    std::ofstream source(sourcePath, std::ios::trunc);
+    if (!pack || !source)
+    {
+        LOG_ERROR("Failed to write source file " << sourcePath << ".");
+        return false;
+    }
+
+    source << "// Generated from " << packPath.filename() << ". Do not edit.\n"
+        << "#include <cstddef>\n\n"
+        << "alignas(" << RESOURCE_PACK_ALIGNMENT << ") extern const unsigned char "
+        << "RESOURCE_PACK_DATA[] =\n{";
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        source << (i % 16 == 0 ? "\n    " : " ")
+            << unsigned(static_cast<unsigned char>(data[i])) << ',';
+    }
+    source << "\n};\n"
+        << "extern const std::size_t RESOURCE_PACK_SIZE = " << data.size() << ";\n";
+    return bool(source.flush());
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr
+            << "Usage: " << argv[0]
+            << " <resources directory> <output pack> [<output C++ source>]\n";
+        return 1;
+    }
+
+    if (!writeResourcePack(argv[1], argv[2]))
+    {
+        return 1;
+    }
+    if (argc > 3 && !writeSource(argv[2], argv[3]))
+    {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <game/bot.h>
+#include <game/consts.h>
+#include <game/log.h>
+#include <game/replay.h>
+#include <game/resource_loader.h>
+#include <game/world.h>
+#include <game/world_inspector.h>
+#include <game/graphics/software_renderer.h>
+
+
+namespace
+{
+
+/// Интервал обновления мира в игре бота.
+const Duration TICK(1.0 / 60);
+/// Количество обновлений мира в игре бота по умолчанию: полминуты игры.
+constexpr std::uint32_t DEFAULT_TICKS = 60 * 30;
+constexpr std::uint32_t SEED = 1;
+/// Начальное положение с наиболее заполненным полем.
+constexpr unsigned int POSITION_INDEX = 5;
+/// Сравнивается каждый такой кадр.
+constexpr std::uint32_t CHECK_PERIOD = 10;
+/// Допустимое отличие компоненты цвета. Кадры должны совпадать побитно.
+constexpr int TOLERANCE = 0;
+/// Код завершения, по которому CTest считает проверку пропущенной.
+constexpr int EXIT_SKIPPED = 77;
+constexpr std::size_t CHANNELS = 4;
+
+
+struct Options
+{
+    /// Запись игры. Если не задана, проверяется игра бота.
+    std::optional<std::filesystem::path> replayPath;
+    std::uint32_t ticks{ DEFAULT_TICKS };
+};
+
+
+/// Отличия двух кадров.
+struct Difference
+{
+    /// Количество пикселей, отличающихся больше допустимого.
+    std::size_t pixels{ 0 };
+    /// Наибольшее отличие компоненты цвета.
+    int maximum{ 0 };
+};
+
+
+/*!
+ * Играет ботом с фиксированными начальными условиями.
+ * \param[in] ticks Наибольшее количество обновлений мира.
+ * \return Запись игры.
+ */
+Replay playBot(std::uint32_t ticks)
+{
+    World world;
+    RandomBot bot(SEED);
+    WorldInspector::start(world, POSITION_INDEX, SEED, std::uint8_t(MAX_CRANES_QUANTITY));
+    for (std::uint32_t i = 0; i < ticks && !world.gameOver(); ++i)
+    {
+        bot.update(world, TICK);
+        world.update(TICK);
+    }
+    return world.replay();
+}
+
+
+Difference compare(const std::uint8_t *expected, const std::uint8_t *actual)
+{
+    Difference result;
+    const std::size_t pixels = std::size_t(SCREEN_SIZE.x) * SCREEN_SIZE.y;
+    for (std::size_t i = 0; i < pixels; ++i)
+    {
+        int pixelDifference = 0;
+        for (std::size_t channel = 0; channel < CHANNELS; ++channel)
+        {
+            const std::size_t index = i * CHANNELS + channel;
+            pixelDifference = std::max(
+                pixelDifference,
+                std::abs(int(expected[index]) - int(actual[index])));
+        }
+        result.maximum = std::max(result.maximum, pixelDifference);
+        if (pixelDifference > TOLERANCE)
+        {
+            ++result.pixels;
+        }
+    }
+    return result;
+}
+
+
+int usage(const char *executable)
+{
+    std::cerr
+        << "Usage: " << executable << " [--replay <file>] [--ticks <N>]\n";
+    return 1;
+}
+
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    try
+    {
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string name = argv[i];
+            const std::string value = argv[i + 1];
+            if (name == "--replay")
+            {
+                options.replayPath = value;
+            }
+            else if (name == "--ticks")
+            {
+                options.ticks = std::uint32_t(std::stoul(value));
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    return argc % 2 == 1;
+}
+
+}
+
+
+/*!
+ * Сравнивает кадры SoftwareRenderer с кадрами, нарисованными SFML
+ * в sf::RenderTexture, как в Window, для записанной игры либо игры бота
+ * с фиксированными начальными условиями.
+ */
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return usage(argv[0]);
+    }
+
+    Log::instance().setMinimumSeverity(Log::Severity::Warning);
+    sf::RenderTexture target;
+    if (!target.create(SCREEN_SIZE.x, SCREEN_SIZE.y))
+    {
+        std::cout << "OpenGL context is not available, the check is skipped.\n";
+        return EXIT_SKIPPED;
+    }
+    target.setSmooth(false);
+    if (!ResourceLoader::instance().openResourcePack(argv[0]) ||
+        !ResourceLoader::instance().load())
+    {
+        LOG_ERROR("Failed to load resources.");
+        return 1;
+    }
+
+    Replay replay;
+    if (options.replayPath.has_value())
+    {
+        if (!readReplay(options.replayPath.value(), replay))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        replay = playBot(options.ticks);
+    }
+
+    World world;
+    world.start(replay);
+    SoftwareRenderer renderer;
+    std::vector<std::uint8_t> frame(
+        SoftwareRenderer::frameSize(SoftwareRenderer::PixelFormat::Rgba));
+
+    std::uint32_t tick = 0;
+    std::size_t framesCompared = 0;
+    std::size_t framesDiffering = 0;
+    int maximumDifference = 0;
+    auto input = replay.inputs.cbegin();
+    for (const Replay::Interval &interval : replay.intervals)
+    {
+        for (std::uint32_t i = 0; i < interval.ticks; ++i, ++tick)
+        {
+            for (; input != replay.inputs.cend() && input->tick == tick; ++input)
+            {
+                if (input->pressed)
+                {
+                    world.handleKeyPressed(input->key);
+                }
+                else
+                {
+                    world.handleKeyReleased(input->key);
+                }
+            }
+            world.update(interval.elapsed);
+            if (tick % CHECK_PERIOD != 0)
+            {
+                continue;
+            }
+
+            // Кадр рисуется так же, как в Window: очистка цветом фона
+            // и вывод мира в текстуру размера экрана.
+            target.clear(BACKGROUND_COLOR);
+            target.draw(world);
+            target.display();
+            const sf::Image expected = target.getTexture().copyToImage();
+            renderer.render(world, frame.data());
+
+            const Difference difference = compare(expected.getPixelsPtr(), frame.data());
+            ++framesCompared;
+            maximumDifference = std::max(maximumDifference, difference.maximum);
+            if (difference.pixels != 0)
+            {
+                if (framesDiffering == 0)
+                {
+                    std::cout << "Frame " << tick << " differs in " << difference.pixels
+                        << " pixels.\n";
+                }
+                ++framesDiffering;
+            }
+        }
+    }
+
+    std::cout
+        << "Channel tolerance: " << TOLERANCE << '\n'
+        << "Frames compared: " << framesCompared << '\n'
+        << "Frames differing: " << framesDiffering << '\n'
+        << "Maximum channel difference: " << maximumDifference << '\n';
+    Log::instance().flush();
+    return framesCompared != 0 && framesDiffering == 0 ? 0 : 1;
+}
@@ -0,0 +1,505 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <game/allocation_tracker.h>
+#include <game/bot.h>
+#include <game/event_log.h>
+#include <game/log.h>
+#include <game/replay.h>
+#include <game/resource_loader.h>
+#include <game/world.h>
+#include <game/world_inspector.h>
+
+
+namespace
+{
+
+constexpr std::uint64_t DEFAULT_FRAMES = 10000000;
+/// Интервал обновления мира.
+const Duration TICK(1.0 / 60);
+/// Период вывода промежуточных результатов.
+constexpr std::chrono::seconds REPORT_PERIOD(10);
+/// Через сколько кадров проверяется, не пора ли вывести результаты.
+constexpr std::uint64_t REPORT_CHECK_PERIOD = 4096;
+const std::filesystem::path DEFAULT_REPLAY_PATH("soak_violation.replay");
+/// Перекрытие объектов, в пикселях игрового мира, меньше которого
+/// объекты считаются соприкасающимися.
+constexpr float OVERLAP_TOLERANCE = 1;
+
+
+enum class InputMode
+{
+    /// Решения бота с паузами между ними, как у игрока.
+    Bot,
+    /// Нажатия и отпускания случайных клавиш на каждом обновлении.
+    Random,
+    /// Как Random, но преимущественно движения в стороны с долгим
+    /// удержанием клавиш, чтобы чаще толкать ящики.
+    Biased
+};
+
+
+struct FuzzKey
+{
+    sf::Keyboard::Key key;
+    /// Вес в режиме Random.
+    unsigned int randomWeight;
+    /// Вес в режиме Biased.
+    unsigned int biasedWeight;
+};
+
+
+const std::array<FuzzKey, 7> FUZZ_KEYS
+{{
+    { sf::Keyboard::Key::Left, 4, 8 },
+    { sf::Keyboard::Key::Right, 4, 8 },
+    { sf::Keyboard::Key::Up, 4, 2 },
+    { sf::Keyboard::Key::Q, 4, 2 },
+    { sf::Keyboard::Key::E, 4, 2 },
+    { sf::Keyboard::Key::Numpad4, 2, 1 },
+    // Пауза и продолжение.
+    { sf::Keyboard::Key::Num0, 1, 0 }
+}};
+
+
+/// Случайные нажатия клавиш на каждом обновлении мира.
+class Fuzzer final
+{
+public:
+    Fuzzer(std::uint32_t seed, bool biased)
+        : m_randomEngine(seed)
+        , m_pressProbability(biased ? 0.1 : 0.3)
+        , m_releaseProbability(biased ? 0.03 : 0.3)
+    {
+        std::vector<unsigned int> weights;
+        for (const FuzzKey &key : FUZZ_KEYS)
+        {
+            weights.push_back(biased ? key.biasedWeight : key.randomWeight);
+        }
+        m_keyDistribution = std::discrete_distribution<std::size_t>(
+            weights.cbegin(),
+            weights.cend());
+    }
+
+    void update(World &world)
+    {
+        std::bernoulli_distribution release(m_releaseProbability);
+        for (auto it = m_pressedKeys.begin(); it != m_pressedKeys.end();)
+        {
+            if (release(m_randomEngine))
+            {
+                world.handleKeyReleased(*it);
+                it = m_pressedKeys.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        std::bernoulli_distribution press(m_pressProbability);
+        if (press(m_randomEngine))
+        {
+            const sf::Keyboard::Key key = FUZZ_KEYS[m_keyDistribution(m_randomEngine)].key;
+            world.handleKeyPressed(key);
+            if (std::find(m_pressedKeys.cbegin(), m_pressedKeys.cend(), key) ==
+                m_pressedKeys.cend())
+            {
+                m_pressedKeys.push_back(key);
+            }
+        }
+    }
+
+    void reset()
+    {
+        m_pressedKeys.clear();
+    }
+
+private:
+    std::mt19937 m_randomEngine;
+    const double m_pressProbability;
+    const double m_releaseProbability;
+    std::discrete_distribution<std::size_t> m_keyDistribution;
+    std::vector<sf::Keyboard::Key> m_pressedKeys;
+};
+
+
+struct Options
+{
+    std::uint64_t frames{ DEFAULT_FRAMES };
+    InputMode inputMode{ InputMode::Random };
+    std::uint8_t cranesQuantity{ 1 };
+    std::uint32_t seed{ 1 };
+    std::filesystem::path replayPath{ DEFAULT_REPLAY_PATH };
+    std::optional<std::filesystem::path> eventLogPath;
+    /// Завершаться с ошибкой, если выделения памяти проверить нельзя.
+    bool allocationsRequired{ false };
+};
+
+
+/// \return \c true, если прямоугольники перекрываются больше допустимого.
+bool overlap(
+    const sf::Vector2f &position1,
+    const sf::Vector2f &size1,
+    const sf::Vector2f &position2,
+    const sf::Vector2f &size2)
+{
+    const float width =
+        std::min(position1.x + size1.x, position2.x + size2.x) -
+        std::max(position1.x, position2.x);
+    const float height =
+        std::min(position1.y + size1.y, position2.y + size2.y) -
+        std::max(position1.y, position2.y);
+    return width > OVERLAP_TOLERANCE && height > OVERLAP_TOLERANCE;
+}
+
+
+/*!
+ * Проверяет инварианты игрового мира.
+ * \return Описание первого нарушенного инварианта.
+ */
+std::optional<std::string> checkInvariants(const World &world)
+{
+    std::stringstream violation;
+    const std::map<Object::Id, BoxPtr> &boxes = WorldInspector::boxes(world);
+    const auto &boxesStatic = WorldInspector::boxesStatic(world);
+    const auto &boxesMoving = WorldInspector::boxesMoving(world);
+
+    if (boxes.size() > MAX_BOXES_QUANTITY)
+    {
+        violation << "Too many boxes: " << boxes.size() << '.';
+        return violation.str();
+    }
+
+    std::vector<const Box*> boxesOnField;
+    for (std::size_t column = 0; column < boxesStatic.size(); ++column)
+    {
+        // Над пустой клеткой может находиться только один ящик,
+        // сдвинутый с более высокой стопки и ещё не начавший падение.
+        std::size_t boxesAboveGap = 0;
+        bool gap = false;
+        for (std::size_t row = 0; row < boxesStatic[column].size(); ++row)
+        {
+            const Object::Id id = boxesStatic[column][row];
+            if (id == NULL_ID)
+            {
+                gap = true;
+                continue;
+            }
+            if (gap && ++boxesAboveGap > 1)
+            {
+                violation << "Column " << column << " has a gap under row " << row << '.';
+                return violation.str();
+            }
+            if (boxesMoving.count(id) != 0)
+            {
+                violation << "Box " << id << " is both static and moving.";
+                return violation.str();
+            }
+            const auto it = boxes.find(id);
+            if (it == boxes.cend())
+            {
+                violation << "Static box " << id << " does not exist.";
+                return violation.str();
+            }
+            boxesOnField.push_back(it->second.get());
+        }
+    }
+    for (const Object::Id id : boxesMoving)
+    {
+        const auto it = boxes.find(id);
+        if (it == boxes.cend())
+        {
+            violation << "Moving box " << id << " does not exist.";
+            return violation.str();
+        }
+        boxesOnField.push_back(it->second.get());
+    }
+
+    const sf::Vector2f boxSize(BOX_SIZE, BOX_SIZE);
+    for (std::size_t i = 0; i < boxesOnField.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < boxesOnField.size(); ++j)
+        {
+            if (overlap(
+                    boxesOnField[i]->getPosition(),
+                    boxSize,
+                    boxesOnField[j]->getPosition(),
+                    boxSize))
+            {
+                violation << "Boxes " << boxesOnField[i]->id()
+                    << " and " << boxesOnField[j]->id() << " overlap.";
+                return violation.str();
+            }
+        }
+    }
+
+    const Player &player = WorldInspector::player(world);
+    const sf::Vector2f playerSize(BOX_SIZE, float(Player::height()));
+    for (const Box *box : boxesOnField)
+    {
+        if (overlap(player.getPosition(), playerSize, box->getPosition(), boxSize))
+        {
+            violation << "Player is inside box " << box->id() << '.';
+            return violation.str();
+        }
+    }
+    return std::nullopt;
+}
+
+
+/// \return Наибольший объём физической памяти процесса, байты.
+std::uint64_t peakResidentSize()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return std::uint64_t(usage.ru_maxrss);
+#else
+    return std::uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+
+double megabytes(std::int64_t bytes)
+{
+    return double(bytes) / (1024 * 1024);
+}
+
+
+int usage(const char *executable)
+{
+    std::cerr
+        << "Usage: " << executable << " [--frames <N>] [--input bot|random|biased]"
+        << " [--cranes <N>] [--seed <N>] [--replay <file>] [--event-log <file>]"
+        << " [--allocations auto|required]\n";
+    return 1;
+}
+
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    try
+    {
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string name = argv[i];
+            const std::string value = argv[i + 1];
+            if (name == "--frames")
+            {
+                options.frames = std::stoull(value);
+            }
+            else if (name == "--input" && value == "bot")
+            {
+                options.inputMode = InputMode::Bot;
+            }
+            else if (name == "--input" && value == "random")
+            {
+                options.inputMode = InputMode::Random;
+            }
+            else if (name == "--input" && value == "biased")
+            {
+                options.inputMode = InputMode::Biased;
+            }
+            else if (name == "--cranes")
+            {
+                options.cranesQuantity = std::uint8_t(
+                    std::clamp<unsigned long>(std::stoul(value), 1, MAX_CRANES_QUANTITY));
+            }
+            else if (name == "--seed")
+            {
+                options.seed = std::uint32_t(std::stoul(value));
+            }
+            else if (name == "--replay")
+            {
+                options.replayPath = value;
+            }
+            else if (name == "--event-log")
+            {
+                options.eventLogPath = value;
+            }
+            else if (name == "--allocations" && value == "auto")
+            {
+                options.allocationsRequired = false;
+            }
+            else if (name == "--allocations" && value == "required")
+            {
+                options.allocationsRequired = true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    return argc % 2 == 1;
+}
+
+}
+
+
+/*!
+ * Играет миллионы кадров без окна со случайным вводом и проверяет
+ * инварианты мира после каждого обновления, в том числе отсутствие
+ * выделений памяти при обновлении идущей игры. При первом нарушении
+ * записывает запись текущей игры, по которой нарушение воспроизводится.
+ */
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return usage(argv[0]);
+    }
+
+    Log::instance().setMinimumSeverity(Log::Severity::Warning);
+    // Журнал событий пишется в файл и может выделять память.
+    const bool checkAllocations =
+        AllocationTracker::enabled() && !options.eventLogPath.has_value();
+    if (!checkAllocations && options.allocationsRequired)
+    {
+        LOG_ERROR(
+            "Allocations cannot be checked: "
+            << (AllocationTracker::enabled()
+                ? "the event log allocates memory."
+                : "allocation tracking is disabled (CMake option ALLOCATION_TRACKING)."));
+        return 1;
+    }
+    if (options.eventLogPath.has_value() &&
+        !EventLog::instance().open(options.eventLogPath.value()))
+    {
+        return 1;
+    }
+    if (!ResourceLoader::instance().loadImages(argv[0]))
+    {
+        LOG_ERROR("Failed to load resources.");
+        return 1;
+    }
+
+    World world;
+    std::uint32_t seed = options.seed;
+    RandomBot bot(seed);
+    Fuzzer fuzzer(seed, options.inputMode == InputMode::Biased);
+    WorldInspector::start(world, std::nullopt, seed, options.cranesQuantity);
+
+    if (!AllocationTracker::enabled())
+    {
+        LOG_WARNING("Allocation tracking is disabled, allocations are not checked.");
+    }
+
+    const std::int64_t initialHeapSize = AllocationTracker::heapSize();
+    const TimePoint start = Clock::now();
+    TimePoint lastReport = start;
+    std::uint64_t games = 1;
+    int result = 0;
+    std::uint64_t frame = 0;
+    for (; frame < options.frames; ++frame)
+    {
+        if (world.gameOver())
+        {
+            // Каждая игра начинается со своим начальным значением, которое
+            // сохраняется в её записи.
+            ++seed;
+            ++games;
+            WorldInspector::start(world, std::nullopt, seed, options.cranesQuantity);
+            bot = RandomBot(seed);
+            fuzzer.reset();
+        }
+
+        if (options.inputMode == InputMode::Bot)
+        {
+            bot.update(world, TICK);
+        }
+        else
+        {
+            fuzzer.update(world);
+        }
+        const AllocationTracker::Counters allocationsBefore = AllocationTracker::thread();
+        world.update(TICK);
+        const AllocationTracker::Counters allocations =
+            AllocationTracker::thread() - allocationsBefore;
+
+        // Во время проигрыша ящик может пересекаться с игроком,
+        // а итоги игры сохраняются с выделением памяти.
+        if (!world.gameOver())
+        {
+            std::optional<std::string> violation = checkInvariants(world);
+            // Первое обновление игры начинает запись интервалов обновлений.
+            if (!violation.has_value() &&
+                checkAllocations &&
+                allocations.allocations != 0 &&
+                world.replay().ticks() > 1)
+            {
+                std::stringstream message;
+                message << "World::update allocated " << allocations.bytes
+                    << " bytes in " << allocations.allocations << " blocks.";
+                violation = message.str();
+            }
+            if (violation.has_value())
+            {
+                LOG_ERROR(
+                    "Invariant violated in game " << games << " (seed " << seed
+                    << ") at tick " << world.replay().ticks() << ": "
+                    << violation.value());
+                writeReplay(options.replayPath, world.replay());
+                result = 1;
+                ++frame;
+                break;
+            }
+        }
+
+        if (frame % REPORT_CHECK_PERIOD == 0 && Clock::now() - lastReport >= REPORT_PERIOD)
+        {
+            lastReport = Clock::now();
+            std::cout << frame << " frames, " << games << " games" << std::endl;
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << std::fixed << std::setprecision(1)
+        << "Frames: " << frame << ", games: " << games << '\n'
+        << "Simulated frames/s: " << (seconds > 0 ? double(frame) / seconds : 0.0) << '\n'
+        << "Peak RSS, MB: " << megabytes(std::int64_t(peakResidentSize())) << '\n'
+        << "Heap growth, MB: " << megabytes(AllocationTracker::heapSize() - initialHeapSize)
+        << " (peak heap " << megabytes(AllocationTracker::heapPeakSize()) << ")\n";
+    if (result != 0)
+    {
+        std::cout << "Replay of the failed game: " << options.replayPath << '\n';
+    }
+
+    EventLog::instance().close();
+    Log::instance().flush();
+    return result;
+}